@@ -0,0 +1,108 @@
+#ifndef MOCKUP_ACTIONS_HPP
+#define MOCKUP_ACTIONS_HPP
+
+#include <mockup/fwd.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace mockup::detail
+{
+  struct converts_to_any
+  {
+    template <typename T>
+    operator T()
+    {
+      return {};
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  namespace helpers
+  {
+    template <typename... Rn>
+    auto return_(Rn&&... rn)
+    {
+      std::array<std::common_type_t<Rn...>, sizeof...(Rn)> r{std::forward<Rn>(rn)...};
+      return [r = std::move(r), i = std::size_t()](auto&&...) mutable {
+        if (i + 1 < r.size())
+        {
+          return r[i++];
+        }
+        else
+        {
+          return r[i];
+        }
+      };
+    }
+
+    template <typename... En>
+    auto throw_(En&&... en)
+    {
+      std::array<std::common_type_t<En...>, sizeof...(En)> r{std::forward<En>(en)...};
+      return [r = std::move(r),
+              i = std::size_t()](auto&&...) mutable -> detail::converts_to_any {
+        if (i + 1 < r.size())
+        {
+          throw r[i++];
+        }
+        else
+        {
+          throw r[i];
+        }
+      };
+    }
+
+    template <typename T>
+    class reference
+    {
+    private:
+      std::decay_t<T>* m_value;
+
+    public:
+      explicit reference(T value)
+      : m_value(&value)
+      {
+      }
+
+      operator T const&() const&
+      {
+        return *m_value;
+      }
+
+      operator T&() &
+      {
+        return *m_value;
+      }
+
+      operator T const &&() const&&
+      {
+        return std::move(*m_value);
+      }
+
+      operator T &&() &&
+      {
+        return std::move(*m_value);
+      }
+
+      bool operator==(std::decay_t<T> const& other) const
+      {
+        return *m_value == other;
+      }
+    };
+
+    template <typename T>
+    auto ref(T&& t)
+    {
+      return reference<T&&>(std::forward<T>(t));
+    };
+  } // namespace helpers
+
+  using namespace helpers;
+} // namespace mockup
+
+#endif // MOCKUP_ACTIONS_HPP
@@ -0,0 +1,65 @@
+#ifndef MOCKUP_C_CALLBACK_HPP
+#define MOCKUP_C_CALLBACK_HPP
+
+#include <mockup/fwd.hpp>
+#include <mockup/mock_function.hpp>
+
+#include <utility>
+
+namespace mockup::detail
+{
+  template <typename>
+  struct trampoline;
+
+  // The trampolines are static member functions, which have C++ language linkage, since
+  // templates cannot have C linkage. Passing them to C relies on the C and C++ calling
+  // conventions being the same, as they are on every platform GCC, Clang and MSVC target.
+  template <typename R, typename... Args>
+  struct trampoline<R(Args...)>
+  {
+    static R context_first(void* context, Args... args)
+    {
+      return (*static_cast<mock_function<R(Args...)> const*>(context))(
+          std::forward<Args>(args)...);
+    }
+
+    static R context_last(Args... args, void* context)
+    {
+      return (*static_cast<mock_function<R(Args...)> const*>(context))(
+          std::forward<Args>(args)...);
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // A C function pointer and the context to pass it. The function is a static
+  // trampoline that casts the context back to the mock_function and calls it, so no
+  // allocation or lookup happens per call. The mock_function must outlive every use
+  // of the callback, and its actions must not throw through C frames.
+  template <typename Signature>
+  struct c_callback
+  {
+    Signature* function;
+    void* context;
+  };
+
+  template <typename R, typename... Args>
+  c_callback<R(void*, Args...)> trampoline(mock_function<R(Args...)> const& function)
+  {
+    return {
+        &detail::trampoline<R(Args...)>::context_first,
+        const_cast<mock_function<R(Args...)>*>(&function)};
+  }
+
+  template <typename R, typename... Args>
+  c_callback<R(Args..., void*)>
+      trampoline_context_last(mock_function<R(Args...)> const& function)
+  {
+    return {
+        &detail::trampoline<R(Args...)>::context_last,
+        const_cast<mock_function<R(Args...)>*>(&function)};
+  }
+} // namespace mockup
+
+#endif // MOCKUP_C_CALLBACK_HPP
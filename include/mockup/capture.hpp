@@ -0,0 +1,59 @@
+#ifndef MOCKUP_CAPTURE_HPP
+#define MOCKUP_CAPTURE_HPP
+
+#include <mockup/detail/capture_policy.hpp>
+#include <mockup/fwd.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace mockup::capture
+{
+  // Capture policies say how the log stores an argument of class type. Arguments of
+  // scalar type are always copied. This header defines how each policy stores
+  // arguments, so it must be included where a policy is set.
+
+  // Stores a copy of the argument. This is the default.
+  struct copy_t
+  {
+  };
+
+  // Stores the address of the argument. The caller guarantees that the argument
+  // outlives its use in checks. Applies only to parameters taken by reference.
+  struct view_t
+  {
+  };
+
+  // Stores nothing. Only wildcards can be matched against the argument.
+  struct none_t
+  {
+  };
+
+  // Stores the address of the argument's copy in the intern table of the mock, which
+  // holds each distinct value once. Values matched against interned arguments are looked
+  // up in the table once per query, and then compared by address.
+  struct intern_t
+  {
+  };
+
+  // Stores the result of a projection of the argument to `std::size_t`, such as its size
+  // or a hash. A value of the argument type is matched by comparing its projection.
+  template <typename Projection>
+  struct projection_t
+  {
+    Projection projection;
+  };
+
+  constexpr copy_t copy{};
+  constexpr view_t view{};
+  constexpr none_t none{};
+  constexpr intern_t intern{};
+
+  template <typename Projection>
+  auto project(Projection&& projection)
+  {
+    return projection_t<std::decay_t<Projection>>{std::forward<Projection>(projection)};
+  }
+} // namespace mockup::capture
+
+#endif // MOCKUP_CAPTURE_HPP
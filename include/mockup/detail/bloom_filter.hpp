@@ -0,0 +1,84 @@
+#ifndef MOCKUP_DETAIL_BLOOM_FILTER_HPP
+#define MOCKUP_DETAIL_BLOOM_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mockup::detail
+{
+  // A set of hashes that may report false positives but never false negatives. Each
+  // hash sets a fixed number of bits, chosen by double hashing.
+  class bloom_filter
+  {
+  private:
+    static constexpr std::size_t hashes = 4;
+
+    std::vector<std::uint64_t> m_words;
+
+    static std::uint64_t mix(std::uint64_t x)
+    {
+      x ^= x >> 30;
+      x *= 0xbf58476d1ce4e5b9ull;
+      x ^= x >> 27;
+      x *= 0x94d049bb133111ebull;
+      x ^= x >> 31;
+      return x;
+    }
+
+    template <typename F>
+    bool all_bits(std::size_t hash, F&& f) const
+    {
+      auto const h1 = mix(hash);
+      auto const h2 = mix(h1) | 1;
+      auto const size = bits();
+      for (std::size_t k = 0; k < hashes; ++k)
+      {
+        if (!f((h1 + k * h2) % size))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  public:
+    // The number of bits is rounded up to a whole number of 64-bit words.
+    static std::size_t round_bits(std::size_t bits)
+    {
+      return (bits + 63) / 64 * 64;
+    }
+
+    explicit bloom_filter(std::size_t bits)
+    : m_words(round_bits(bits) / 64)
+    {
+    }
+
+    std::size_t bits() const
+    {
+      return m_words.size() * 64;
+    }
+
+    void insert(std::size_t hash)
+    {
+      all_bits(hash, [&](std::uint64_t bit) {
+        m_words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+        return true;
+      });
+    }
+
+    bool might_contain(std::size_t hash) const
+    {
+      return all_bits(hash, [&](std::uint64_t bit) {
+        return (m_words[bit / 64] >> (bit % 64) & 1) != 0;
+      });
+    }
+
+    void clear()
+    {
+      m_words.assign(m_words.size(), 0);
+    }
+  };
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_BLOOM_FILTER_HPP
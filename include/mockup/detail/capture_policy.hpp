@@ -0,0 +1,188 @@
+#ifndef MOCKUP_DETAIL_CAPTURE_POLICY_HPP
+#define MOCKUP_DETAIL_CAPTURE_POLICY_HPP
+
+#include <mockup/detail/captured.hpp>
+#include <mockup/detail/hash.hpp>
+#include <mockup/detail/intern_table.hpp>
+#include <mockup/fwd.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace mockup::detail
+{
+  template <typename T>
+  class view_policy : public capture_policy<T>
+  {
+  public:
+    captured<T> capture(T const& value) const override
+    {
+      return captured<T>::viewed(value);
+    }
+
+    bool holds(captured<T> const& argument, T const& value) const override
+    {
+      return argument.viewed() == &value;
+    }
+  };
+
+  template <typename T>
+  class none_policy : public capture_policy<T>
+  {
+  public:
+    captured<T> capture(T const&) const override
+    {
+      return {};
+    }
+
+    bool holds(captured<T> const& argument, T const&) const override
+    {
+      return argument.empty();
+    }
+  };
+
+  template <typename T>
+  class intern_policy : public capture_policy<T>
+  {
+  private:
+    std::shared_ptr<intern_table<T>> m_table;
+
+  public:
+    explicit intern_policy(std::shared_ptr<intern_table<T>> table)
+    : m_table(std::move(table))
+    {
+    }
+
+    captured<T> capture(T const& value) const override
+    {
+      return captured<T>::interned(m_table->insert(value));
+    }
+
+    bool holds(captured<T> const& argument, T const& value) const override
+    {
+      auto const* interned = argument.interned();
+      return interned != nullptr && is_equal(*interned, value);
+    }
+
+    bool is_exact() const override
+    {
+      return true;
+    }
+
+    bool interns() const override
+    {
+      return true;
+    }
+
+    T const* find(T const& value) const override
+    {
+      return m_table->find(value);
+    }
+  };
+
+  template <typename T>
+  class projection_policy : public capture_policy<T>
+  {
+  private:
+    std::function<std::size_t(T const&)> m_projection;
+
+  public:
+    explicit projection_policy(std::function<std::size_t(T const&)> projection)
+    : m_projection(std::move(projection))
+    {
+    }
+
+    captured<T> capture(T const& value) const override
+    {
+      return captured<T>::projected_by(m_projection(value), *this);
+    }
+
+    bool holds(captured<T> const& argument, T const& value) const override
+    {
+      auto const* projected = argument.projection();
+      return projected != nullptr && projected->policy == this &&
+             projected->value == m_projection(value);
+    }
+
+    std::size_t project(T const& value) const override
+    {
+      return m_projection(value);
+    }
+  };
+
+  // Copies are stored inline, so the default policy has no object.
+  template <typename Param>
+  struct capture_policy_for<Param, capture::copy_t>
+  {
+    static capture_policy_ptr<std::decay_t<Param>>
+        make(capture::copy_t const&, std::shared_ptr<intern_tables>&)
+    {
+      return nullptr;
+    }
+  };
+
+  template <typename Param>
+  struct capture_policy_for<Param, capture::view_t>
+  {
+    // A parameter taken by value is a copy that ends with the call, so its address
+    // cannot be kept.
+    static_assert(
+        std::is_reference_v<Param>, "capture::view applies to arguments passed by reference");
+
+    static capture_policy_ptr<std::decay_t<Param>>
+        make(capture::view_t const&, std::shared_ptr<intern_tables>&)
+    {
+      return std::make_shared<view_policy<std::decay_t<Param>> const>();
+    }
+  };
+
+  template <typename Param>
+  struct capture_policy_for<Param, capture::none_t>
+  {
+    static capture_policy_ptr<std::decay_t<Param>>
+        make(capture::none_t const&, std::shared_ptr<intern_tables>&)
+    {
+      return std::make_shared<none_policy<std::decay_t<Param>> const>();
+    }
+  };
+
+  template <typename Param>
+  struct capture_policy_for<Param, capture::intern_t>
+  {
+    using type = std::decay_t<Param>;
+
+    static_assert(is_hashable_v<type>, "interned arguments must be hashable");
+
+    // The intern tables of a mock are made when its first argument is interned.
+    static capture_policy_ptr<type>
+        make(capture::intern_t const&, std::shared_ptr<intern_tables>& tables)
+    {
+      if (!tables)
+      {
+        tables = std::make_shared<intern_tables>();
+      }
+      return std::make_shared<intern_policy<type> const>(tables->template get<type>());
+    }
+  };
+
+  template <typename Param, typename Projection>
+  struct capture_policy_for<Param, capture::projection_t<Projection>>
+  {
+    using type = std::decay_t<Param>;
+
+    static_assert(
+        std::is_convertible_v<std::invoke_result_t<Projection const&, type const&>, std::size_t>,
+        "projection must map the argument to std::size_t");
+
+    static capture_policy_ptr<type> make(
+        capture::projection_t<Projection> const& policy, std::shared_ptr<intern_tables>&)
+    {
+      return std::make_shared<projection_policy<type> const>(policy.projection);
+    }
+  };
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_CAPTURE_POLICY_HPP
@@ -0,0 +1,389 @@
+#ifndef MOCKUP_DETAIL_CAPTURED_HPP
+#define MOCKUP_DETAIL_CAPTURED_HPP
+
+#include <mockup/detail/compare.hpp>
+#include <mockup/matchers.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mockup::detail
+{
+  template <typename T, typename = void>
+  struct is_equality_comparable : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct is_equality_comparable<
+      T,
+      std::enable_if_t<std::is_convertible_v<
+          decltype(std::declval<T const&>() == std::declval<T const&>()),
+          bool>>> : std::true_type
+  {
+  };
+
+  // Whether two values are the same. Floating-point zeros of different signs are not,
+  // and values of types without `==` never are.
+  template <typename T>
+  bool is_equal(T const& lhs, T const& rhs)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      return lhs == rhs && std::signbit(lhs) == std::signbit(rhs);
+    }
+    else if constexpr (is_equality_comparable<T>::value)
+    {
+      return static_cast<bool>(lhs == rhs);
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  template <typename T>
+  class captured;
+
+  // How the log stores an argument of class type, as set with `capture`. Copying is
+  // the default and has no policy object; the other policies are defined with the
+  // capture policies, so that only code which sets one pays for them.
+  template <typename T>
+  class capture_policy
+  {
+  public:
+    virtual ~capture_policy() = default;
+
+    virtual captured<T> capture(T const& value) const = 0;
+
+    // Whether `value`, captured with this policy, would be stored as `argument` is.
+    virtual bool holds(captured<T> const& argument, T const& value) const = 0;
+
+    // Whether arguments are stored as their values, so that matching them compares the
+    // values that were passed.
+    virtual bool is_exact() const
+    {
+      return false;
+    }
+
+    // Whether arguments are stored in an intern table, which `find` looks values up in.
+    virtual bool interns() const
+    {
+      return false;
+    }
+
+    // The interned copy of `value`, or null if it was never interned.
+    virtual T const* find(T const&) const
+    {
+      return nullptr;
+    }
+
+    // The projection of `value`, for policies that store projections.
+    virtual std::size_t project(T const&) const
+    {
+      return 0;
+    }
+  };
+
+  template <typename T>
+  using capture_policy_ptr = std::shared_ptr<capture_policy<T> const>;
+
+  // Makes the policy object for the capture policy `Policy` of a parameter of type
+  // `Param`, defined for each policy in `detail/capture_policy.hpp`.
+  template <typename Param, typename Policy>
+  struct capture_policy_for;
+
+  // An argument of class type, stored as its capture policy said when it was recorded.
+  // Copies made by the default policy are held inline, so that recording them costs no
+  // more than before policies existed. Other policies store only addresses: interned
+  // values are kept by the intern table of the mock, and projections refer to the
+  // policies that made them, which the log keeps.
+  template <typename T>
+  class captured
+  {
+  public:
+    struct projected
+    {
+      std::size_t value;
+      capture_policy<T> const* policy;
+    };
+
+  private:
+    enum class kind : unsigned char
+    {
+      none,
+      copied,
+      viewed,
+      interned,
+      projected
+    };
+
+    union
+    {
+      T m_copy;
+      T const* m_value;
+      projected m_projected;
+    };
+    kind m_kind = kind::none;
+
+    captured(kind stored, T const* value)
+    : m_value(value)
+    , m_kind(stored)
+    {
+    }
+
+    template <typename Other>
+    void construct(Other&& other)
+    {
+      switch (other.m_kind)
+      {
+      case kind::copied:
+        new (&m_copy) T(std::forward<Other>(other).m_copy);
+        break;
+      case kind::projected:
+        m_projected = other.m_projected;
+        break;
+      default:
+        m_value = other.m_value;
+        break;
+      }
+      m_kind = other.m_kind;
+    }
+
+    void destroy()
+    {
+      if (m_kind == kind::copied)
+      {
+        m_copy.~T();
+      }
+      m_kind = kind::none;
+      m_value = nullptr;
+    }
+
+  public:
+    // Nothing, as `capture::none` stores it.
+    captured()
+    : m_value(nullptr)
+    {
+    }
+
+    // A copy of `value`, as the default policy stores it.
+    explicit captured(T const& value)
+    : m_copy(value)
+    , m_kind(kind::copied)
+    {
+    }
+
+    static captured viewed(T const& value)
+    {
+      return {kind::viewed, &value};
+    }
+
+    static captured interned(T const* value)
+    {
+      return {kind::interned, value};
+    }
+
+    static captured projected_by(std::size_t value, capture_policy<T> const& policy)
+    {
+      captured result;
+      result.m_projected = projected{value, &policy};
+      result.m_kind = kind::projected;
+      return result;
+    }
+
+    captured(captured const& other)
+    : m_value(nullptr)
+    {
+      construct(other);
+    }
+
+    captured(captured&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    : m_value(nullptr)
+    {
+      construct(std::move(other));
+    }
+
+    captured& operator=(captured const& other)
+    {
+      if (this != &other)
+      {
+        destroy();
+        construct(other);
+      }
+      return *this;
+    }
+
+    captured& operator=(captured&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+      if (this != &other)
+      {
+        destroy();
+        construct(std::move(other));
+      }
+      return *this;
+    }
+
+    ~captured()
+    {
+      destroy();
+    }
+
+    // The argument, if it was copied, viewed or interned.
+    T const* value() const
+    {
+      switch (m_kind)
+      {
+      case kind::copied:
+        return &m_copy;
+      case kind::viewed:
+      case kind::interned:
+        return m_value;
+      default:
+        return nullptr;
+      }
+    }
+
+    // Whether `value`, captured with `policy`, or copied if it is null, would be stored
+    // the same way, so that the two calls cannot be told apart from the log.
+    bool holds(T const& value, capture_policy<T> const* policy) const
+    {
+      if (policy)
+      {
+        return policy->holds(*this, value);
+      }
+      return m_kind == kind::copied && is_equal(m_copy, value);
+    }
+
+    bool empty() const
+    {
+      return m_kind == kind::none;
+    }
+
+    T const* viewed() const
+    {
+      return m_kind == kind::viewed ? m_value : nullptr;
+    }
+
+    // The interned argument, which is equal to another interned value only if it has the
+    // same address.
+    T const* interned() const
+    {
+      return m_kind == kind::interned ? m_value : nullptr;
+    }
+
+    projected const* projection() const
+    {
+      return m_kind == kind::projected ? &m_projected : nullptr;
+    }
+
+    T const& get() const
+    {
+      if (auto const* result = value())
+      {
+        return *result;
+      }
+      throw std::logic_error("argument was not captured by its capture policy");
+    }
+  };
+
+  // A value matched against an argument that may be interned: `id` is its interned copy,
+  // or null if it was never interned, in which case no interned argument is equal to it.
+  template <typename T>
+  struct interned_query
+  {
+    T const* id;
+    T const* value;
+  };
+
+  // Matches an argument whatever its capture policy. A projected argument can only be
+  // compared with a value of its type, or with `equal_to` or `not_equal_to` one.
+  template <typename Matcher, typename T>
+  bool match_captured(Matcher const& matcher, captured<T> const& argument)
+  {
+    if constexpr (std::is_same_v<Matcher, wildcard_t>)
+    {
+      return true;
+    }
+    else
+    {
+      if (auto const* value = argument.value())
+      {
+        return matcher == *value;
+      }
+      if (auto const* projected = argument.projection())
+      {
+        if constexpr (std::is_same_v<Matcher, T>)
+        {
+          return projected->policy->project(matcher) == projected->value;
+        }
+        else if constexpr (compare_matcher<Matcher>::value)
+        {
+          using op = typename compare_matcher<Matcher>::op;
+          if constexpr (
+              std::is_same_v<typename compare_matcher<Matcher>::type, T> &&
+              (std::is_same_v<op, equal> || std::is_same_v<op, not_equal>))
+          {
+            auto const& operand = predicate_access::get(matcher).value;
+            return op::apply(projected->value, projected->policy->project(operand));
+          }
+        }
+      }
+      throw std::logic_error("matcher cannot be applied to an argument that was not captured");
+    }
+  }
+
+  // Whether `Matcher` can be compared with an argument of type `T`, as a value or a
+  // matcher of its own.
+  template <typename Matcher, typename T, typename = void>
+  struct is_matcher_for : std::false_type
+  {
+  };
+
+  template <typename Matcher, typename T>
+  struct is_matcher_for<
+      Matcher,
+      T,
+      std::enable_if_t<std::is_convertible_v<
+          decltype(std::declval<Matcher const&>() == std::declval<T const&>()),
+          bool>>> : std::true_type
+  {
+  };
+
+  template <
+      typename Matcher,
+      typename T,
+      typename = std::enable_if_t<is_matcher_for<Matcher, T>::value>>
+  bool operator==(Matcher const& matcher, captured<T> const& argument)
+  {
+    return match_captured(matcher, argument);
+  }
+
+  template <typename P, typename T>
+  bool operator==(predicate_t<P> const& matcher, captured<T> const& argument)
+  {
+    return match_captured(matcher, argument);
+  }
+
+  template <typename T>
+  bool operator==(interned_query<T> const& query, captured<T> const& argument)
+  {
+    if (auto const* interned = argument.interned())
+    {
+      return interned == query.id;
+    }
+    return match_captured(*query.value, argument);
+  }
+
+  template <typename T>
+  bool operator==(wildcard_t, captured<T> const&)
+  {
+    return true;
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_CAPTURED_HPP
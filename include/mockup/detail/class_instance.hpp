@@ -0,0 +1,59 @@
+#ifndef MOCKUP_DETAIL_CLASS_INSTANCE_HPP
+#define MOCKUP_DETAIL_CLASS_INSTANCE_HPP
+
+#include <mockup/fwd.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mockup::detail
+{
+  // Settings shared by all the mocked member functions of one mock object.
+  struct mock_settings
+  {
+    bool strict = false;
+    std::size_t filter_bits = 0;
+    // Made when an argument is first interned.
+    std::shared_ptr<intern_tables> interns;
+  };
+
+  struct class_instance
+  {
+    std::vector<std::function<void()>> destructors;
+    mock_settings settings;
+  };
+
+  template <typename Mock>
+  struct class_
+  {
+    static std::map<Mock const*, class_instance> instances;
+  };
+
+  template <typename Mock>
+  std::map<Mock const*, class_instance> class_<Mock>::instances;
+
+  template <typename Mock>
+  class_instance& get_class_instance(Mock const* mock)
+  {
+    return class_<Mock>::instances[mock];
+  }
+
+  template <typename Mock>
+  void destroy_class_instance(Mock const* mock)
+  {
+    auto& instances = class_<Mock>::instances;
+    if (auto it = instances.find(mock); it != instances.end())
+    {
+      for (auto& destructor : it->second.destructors)
+      {
+        destructor();
+      }
+      instances.erase(it);
+    }
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_CLASS_INSTANCE_HPP
@@ -0,0 +1,111 @@
+#ifndef MOCKUP_DETAIL_COMPARE_HPP
+#define MOCKUP_DETAIL_COMPARE_HPP
+
+#include <mockup/fwd.hpp>
+
+#include <type_traits>
+
+namespace mockup::detail
+{
+  struct equal
+  {
+    template <typename T, typename U>
+    static bool apply(T const& x, U const& value)
+    {
+      return x == value;
+    }
+  };
+
+  struct not_equal
+  {
+    template <typename T, typename U>
+    static bool apply(T const& x, U const& value)
+    {
+      return x != value;
+    }
+  };
+
+  struct less
+  {
+    template <typename T, typename U>
+    static bool apply(T const& x, U const& value)
+    {
+      return x < value;
+    }
+  };
+
+  struct less_equal
+  {
+    template <typename T, typename U>
+    static bool apply(T const& x, U const& value)
+    {
+      return x <= value;
+    }
+  };
+
+  struct greater
+  {
+    template <typename T, typename U>
+    static bool apply(T const& x, U const& value)
+    {
+      return x > value;
+    }
+  };
+
+  struct greater_equal
+  {
+    template <typename T, typename U>
+    static bool apply(T const& x, U const& value)
+    {
+      return x >= value;
+    }
+  };
+
+  // The predicate of the built-in comparison matchers. Unlike a lambda, its operation
+  // and operand can be inspected, which lets queries over a log column evaluate it for
+  // many recorded arguments at once.
+  template <typename Op, typename T>
+  struct compare
+  {
+    T value;
+
+    template <typename X>
+    bool operator()(X const& x) const
+    {
+      return Op::apply(x, value);
+    }
+  };
+
+  template <typename Matcher>
+  struct is_compare : std::false_type
+  {
+  };
+
+  template <typename Op, typename T>
+  struct is_compare<compare<Op, T>> : std::true_type
+  {
+  };
+
+  template <typename Matcher>
+  struct compare_matcher : std::false_type
+  {
+  };
+
+  template <typename Op, typename T>
+  struct compare_matcher<predicate_t<compare<Op, T>>> : std::true_type
+  {
+    using op = Op;
+    using type = T;
+  };
+
+  struct predicate_access
+  {
+    template <typename Predicate>
+    static auto const& get(Predicate const& predicate)
+    {
+      return predicate.m_predicate;
+    }
+  };
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_COMPARE_HPP
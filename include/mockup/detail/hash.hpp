@@ -0,0 +1,42 @@
+#ifndef MOCKUP_DETAIL_HASH_HPP
+#define MOCKUP_DETAIL_HASH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+namespace mockup::detail
+{
+  template <typename T>
+  constexpr bool is_hashable_v = std::is_default_constructible_v<std::hash<T>>;
+
+  inline std::size_t hash_combine(std::size_t seed, std::size_t value)
+  {
+    return seed ^
+           (value + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+  }
+
+  template <typename... Ts>
+  std::size_t hash_values(Ts const&... values)
+  {
+    std::size_t seed = sizeof...(Ts);
+    (..., (seed = hash_combine(seed, std::hash<Ts>()(values))));
+    return seed;
+  }
+
+  struct tuple_hash
+  {
+    template <typename... Ts>
+    std::size_t operator()(std::tuple<Ts...> const& values) const
+    {
+      return std::apply(
+          [](auto const&... values) {
+            return hash_values(values...);
+          },
+          values);
+    }
+  };
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_HASH_HPP
@@ -0,0 +1,60 @@
+#ifndef MOCKUP_DETAIL_INTERN_TABLE_HPP
+#define MOCKUP_DETAIL_INTERN_TABLE_HPP
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <typeindex>
+#include <unordered_set>
+
+namespace mockup::detail
+{
+  // Each distinct value stored once. The address of a stored value never changes, so it
+  // identifies the value: two interned values are equal when their addresses are.
+  template <typename T>
+  class intern_table
+  {
+  private:
+    std::unordered_set<T> m_values;
+
+  public:
+    T const* insert(T const& value)
+    {
+      return &*m_values.insert(value).first;
+    }
+
+    // The interned copy of `value`, or null if it was never interned.
+    T const* find(T const& value) const
+    {
+      auto const it = m_values.find(value);
+      return it == m_values.end() ? nullptr : &*it;
+    }
+
+    std::size_t size() const
+    {
+      return m_values.size();
+    }
+  };
+
+  // The intern tables of one mock, one per argument type, so that a value passed to
+  // several of its member functions is stored once.
+  class intern_tables
+  {
+  private:
+    std::map<std::type_index, std::shared_ptr<void>> m_tables;
+
+  public:
+    template <typename T>
+    std::shared_ptr<intern_table<T>> get()
+    {
+      auto& table = m_tables[typeid(T)];
+      if (!table)
+      {
+        table = std::make_shared<intern_table<T>>();
+      }
+      return std::static_pointer_cast<intern_table<T>>(table);
+    }
+  };
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_INTERN_TABLE_HPP
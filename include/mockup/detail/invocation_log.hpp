@@ -0,0 +1,878 @@
+#ifndef MOCKUP_DETAIL_INVOCATION_LOG_HPP
+#define MOCKUP_DETAIL_INVOCATION_LOG_HPP
+
+#include <mockup/detail/bloom_filter.hpp>
+#include <mockup/detail/captured.hpp>
+#include <mockup/detail/hash.hpp>
+#include <mockup/detail/run_index.hpp>
+#include <mockup/detail/spill_storage.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/layout.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mockup::detail
+{
+  // Refers to an argument that cannot be copied into the log, such as one passed with
+  // `ref()`. The caller guarantees that the argument outlives its use in checks.
+  template <typename T>
+  class stored_reference
+  {
+  private:
+    T const* m_value;
+
+  public:
+    template <typename U>
+    explicit stored_reference(U const& value)
+    : m_value(&static_cast<T const&>(value))
+    {
+    }
+
+    T const& get() const
+    {
+      return *m_value;
+    }
+  };
+
+  // Whether the log takes ownership of an argument: move-only arguments taken by value
+  // are moved into it.
+  template <typename Arg>
+  constexpr bool owns_argument_v = !std::is_reference_v<Arg> &&
+                                   !std::is_copy_constructible_v<std::decay_t<Arg>> &&
+                                   std::is_move_constructible_v<std::decay_t<Arg>>;
+
+  // Copyable arguments of class type are stored as their capture policy says; other
+  // copyable arguments are copied, and owned arguments are moved.
+  template <typename Arg>
+  using stored_t = std::conditional_t<
+      std::is_copy_constructible_v<std::decay_t<Arg>>,
+      std::conditional_t<
+          std::is_class_v<std::decay_t<Arg>>,
+          captured<std::decay_t<Arg>>,
+          std::decay_t<Arg>>,
+      std::conditional_t<
+          owns_argument_v<Arg>,
+          std::decay_t<Arg>,
+          stored_reference<std::decay_t<Arg>>>>;
+
+  template <typename Stored>
+  struct is_captured : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct is_captured<captured<T>> : std::true_type
+  {
+  };
+
+  // What matchers are compared with: captured arguments themselves, so that arguments
+  // stored by projection can still be matched, and the values of the others.
+  template <typename Arg>
+  using matchable_t = std::
+      conditional_t<is_captured<stored_t<Arg>>::value, stored_t<Arg>, std::decay_t<Arg>>;
+
+  // A bool in a column, since std::vector<bool> cannot hand out references.
+  struct stored_bool
+  {
+    bool value;
+  };
+
+  template <typename Stored>
+  using column_t = std::conditional_t<std::is_same_v<Stored, bool>, stored_bool, Stored>;
+
+  template <typename Stored>
+  Stored from_column(column_t<Stored>&& stored)
+  {
+    if constexpr (std::is_same_v<Stored, bool>)
+    {
+      return stored.value;
+    }
+    else
+    {
+      return std::move(stored);
+    }
+  }
+
+  template <typename Arg, typename Stored>
+  std::decay_t<Arg> const& unwrap(Stored const& stored)
+  {
+    if constexpr (std::is_same_v<Stored, std::decay_t<Arg>>)
+    {
+      return stored;
+    }
+    else if constexpr (std::is_same_v<Stored, stored_bool>)
+    {
+      return stored.value;
+    }
+    else
+    {
+      return stored.get();
+    }
+  }
+
+  template <typename Arg, typename Stored>
+  matchable_t<Arg> const& matchable(Stored const& stored)
+  {
+    if constexpr (is_captured<Stored>::value)
+    {
+      return stored;
+    }
+    else
+    {
+      return unwrap<Arg>(stored);
+    }
+  }
+
+  template <typename Stored>
+  bool has_value(Stored const& stored)
+  {
+    if constexpr (is_captured<Stored>::value)
+    {
+      return stored.value() != nullptr;
+    }
+    else
+    {
+      return true;
+    }
+  }
+
+  // Stores `arg` as `policy` says, or copies it if the policy is null.
+  template <typename Arg, typename FuncArg, typename Policy>
+  stored_t<Arg> make_stored(FuncArg&& arg, Policy const& policy)
+  {
+    if constexpr (is_captured<stored_t<Arg>>::value)
+    {
+      return policy ? policy->capture(arg) : stored_t<Arg>(arg);
+    }
+    else if constexpr (owns_argument_v<Arg>)
+    {
+      return stored_t<Arg>(std::forward<FuncArg>(arg));
+    }
+    else
+    {
+      return stored_t<Arg>(arg);
+    }
+  }
+
+  // Whether a call with argument `arg` would be stored as `stored` was.
+  template <typename Arg, typename Stored, typename FuncArg, typename Policy>
+  bool is_same_argument(Stored const& stored, FuncArg const& arg, Policy const& policy)
+  {
+    if constexpr (is_captured<Stored>::value)
+    {
+      return stored.holds(arg, policy.get());
+    }
+    else if constexpr (std::is_same_v<Stored, stored_reference<std::decay_t<Arg>>>)
+    {
+      return &stored.get() == &static_cast<std::decay_t<Arg> const&>(arg);
+    }
+    else
+    {
+      return is_equal<std::decay_t<Arg>>(unwrap<Arg>(stored), arg);
+    }
+  }
+
+  template <typename... Args>
+  struct invocation
+  {
+    std::tuple<stored_t<Args>...> arguments;
+    std::size_t order;
+  };
+
+  template <typename... Args>
+  class invocation_log;
+
+  // A recorded invocation, referred to by its position in the log.
+  template <typename... Args>
+  class invocation_ref
+  {
+  private:
+    invocation_log<Args...> const* m_log;
+    std::size_t m_index;
+
+  public:
+    invocation_ref(invocation_log<Args...> const& log, std::size_t index)
+    : m_log(&log)
+    , m_index(index)
+    {
+    }
+
+    std::size_t order() const
+    {
+      return m_log->order(m_index);
+    }
+
+    template <std::size_t I>
+    decltype(auto) get() const
+    {
+      return m_log->template get<I>(m_index);
+    }
+
+    std::tuple<std::decay_t<Args> const&...> arguments() const
+    {
+      return m_log->arguments(m_index);
+    }
+
+    template <typename F>
+    bool match(F&& f) const
+    {
+      return m_log->match(m_index, std::forward<F>(f));
+    }
+  };
+
+  // The typed record of the calls made to one member function, in call order. By
+  // default each invocation is stored as one row; the column layout instead stores each
+  // argument position contiguously, so that a query on one argument streams through
+  // dense memory.
+  template <typename... Args>
+  class invocation_log
+  {
+  private:
+    log_layout m_layout = log_layout::rows;
+    std::vector<invocation<Args...>> m_invocations;
+    std::vector<std::size_t> m_orders;
+    std::tuple<std::vector<column_t<stored_t<Args>>>...> m_columns;
+    // The capture policy of each argument position, null while arguments are copied.
+    std::tuple<capture_policy_ptr<std::decay_t<Args>>...> m_policies;
+    // The last intern policy of each position, in whose table values are looked up.
+    std::tuple<capture_policy_ptr<std::decay_t<Args>>...> m_interns;
+    // Every policy set, since recorded arguments may refer to them.
+    std::vector<std::shared_ptr<void const>> m_kept_policies;
+    std::optional<bloom_filter> m_filter;
+    bool m_filter_complete = true;
+    // Whether a call was recorded with an argument matched by something other than the
+    // value passed, such as its projection. The filter holds the hashes of the values
+    // passed, so it could then give false negatives, and is not used until the log is
+    // cleared.
+    bool m_filter_inexact = false;
+    // With run-length compression, each stored invocation stands for a run of identical
+    // calls with consecutive orders.
+    run_index m_runs;
+    // The first `m_spilled` invocations are in the spill file, if there is one.
+    std::unique_ptr<spill_storage> m_spill;
+    std::size_t m_spill_threshold = 0;
+    std::size_t m_spilled = 0;
+
+    static constexpr bool is_filterable = (... && is_hashable_v<std::decay_t<Args>>);
+
+    template <typename... FuncArgs>
+    static std::size_t hash(FuncArgs const&... args)
+    {
+      return hash_values<std::decay_t<Args>...>(args...);
+    }
+
+    // Logs whose arguments are all stored as values of trivially copyable types can
+    // spill to a file of fixed-layout records: the order, the end of the run, then the
+    // arguments.
+    static constexpr bool is_spillable =
+        (... &&
+         (std::is_same_v<stored_t<Args>, std::decay_t<Args>> &&
+          std::is_trivially_copyable_v<std::decay_t<Args>>));
+
+    using record = record_layout<
+        std::size_t,
+        std::size_t,
+        std::conditional_t<is_spillable, stored_t<Args>, std::size_t>...>;
+
+    template <std::size_t Field>
+    using field_t = std::tuple_element_t<
+        Field,
+        std::tuple<
+            std::size_t,
+            std::size_t,
+            std::conditional_t<is_spillable, stored_t<Args>, std::size_t>...>>;
+
+    template <std::size_t Field>
+    field_t<Field> const& field(std::size_t entry) const
+    {
+      return *reinterpret_cast<field_t<Field> const*>(
+          m_spill->data() + entry * record::size + record::offsets[Field]);
+    }
+
+    template <std::size_t Field>
+    field_t<Field>& field(std::size_t entry)
+    {
+      return *reinterpret_cast<field_t<Field>*>(
+          m_spill->data() + entry * record::size + record::offsets[Field]);
+    }
+
+    // The number of invocations held in memory.
+    std::size_t resident_entries() const
+    {
+      return m_layout == log_layout::rows ? m_invocations.size() : m_orders.size();
+    }
+
+    std::size_t entries() const
+    {
+      return m_spilled + resident_entries();
+    }
+
+    std::size_t run_end(std::size_t entry) const
+    {
+      if (!m_runs.enabled())
+      {
+        return entry + 1;
+      }
+      return entry < m_spilled ? field<1>(entry) : m_runs.end(entry - m_spilled);
+    }
+
+    std::size_t run_begin(std::size_t entry) const
+    {
+      return entry == 0 ? 0 : run_end(entry - 1);
+    }
+
+    std::size_t run_length(std::size_t entry) const
+    {
+      return run_end(entry) - run_begin(entry);
+    }
+
+    // The stored invocation of the call at `index`.
+    std::size_t entry(std::size_t index) const
+    {
+      if (!m_runs.enabled())
+      {
+        return index;
+      }
+      return find_run(entries(), index, [this](std::size_t entry) {
+        return run_end(entry);
+      });
+    }
+
+    std::size_t entry_order(std::size_t entry) const
+    {
+      if (entry < m_spilled)
+      {
+        return field<0>(entry);
+      }
+      entry -= m_spilled;
+      return m_layout == log_layout::rows ? m_invocations[entry].order : m_orders[entry];
+    }
+
+    template <std::size_t I, typename F>
+    decltype(auto) with_stored_entry(std::size_t entry, F&& f) const
+    {
+      if constexpr (is_spillable)
+      {
+        if (entry < m_spilled)
+        {
+          return f(field<I + 2>(entry));
+        }
+      }
+      entry -= m_spilled;
+      if (m_layout == log_layout::rows)
+      {
+        return f(std::get<I>(m_invocations[entry].arguments));
+      }
+      return f(std::get<I>(m_columns)[entry]);
+    }
+
+    // Moves the invocations held in memory to the end of the spill file.
+    template <std::size_t... I>
+    void spill(std::index_sequence<I...>)
+    {
+      auto const first = m_spilled;
+      auto const last = entries();
+      auto* data = m_spill->append((last - first) * record::size);
+      for (auto e = first; e != last; ++e, data += record::size)
+      {
+        auto const order = entry_order(e);
+        auto const end = run_end(e);
+        std::memcpy(data + record::offsets[0], &order, sizeof(order));
+        std::memcpy(data + record::offsets[1], &end, sizeof(end));
+        (...,
+         with_stored_entry<I>(e, [&](auto const& stored) {
+           field_t<I + 2> const value = unwrap<field_t<I + 2>>(stored);
+           std::memcpy(data + record::offsets[I + 2], &value, sizeof(value));
+           return 0;
+         }));
+      }
+      m_spilled = last;
+      m_invocations.clear();
+      m_orders.clear();
+      m_runs.clear();
+      std::apply(
+          [](auto&... columns) {
+            (..., columns.clear());
+          },
+          m_columns);
+    }
+
+    void extend_run()
+    {
+      auto const last = entries() - 1;
+      if constexpr (is_spillable)
+      {
+        if (last < m_spilled)
+        {
+          ++field<1>(last);
+          return;
+        }
+      }
+      m_runs.extend();
+    }
+
+    // Calls `f` with the stored form of argument `I` of the invocation at `index`.
+    template <std::size_t I, typename F>
+    decltype(auto) with_stored(std::size_t index, F&& f) const
+    {
+      return with_stored_entry<I>(entry(index), std::forward<F>(f));
+    }
+
+    // Whether a call made with `order` and `args` continues the last run. Calls whose
+    // arguments the log owns are never merged, since their actions are passed the
+    // stored arguments.
+    template <std::size_t... I, typename... FuncArgs>
+    bool extends_run(
+        std::size_t order, std::index_sequence<I...>, FuncArgs const&... args) const
+    {
+      if constexpr ((... || owns_argument_v<Args>))
+      {
+        return false;
+      }
+      else
+      {
+        if (!m_runs.compressing() || entries() == 0)
+        {
+          return false;
+        }
+        auto const last = entries() - 1;
+        return order == entry_order(last) + run_length(last) &&
+               (... && with_stored_entry<I>(last, [&](auto const& stored) {
+                  return is_same_argument<Args>(stored, args, std::get<I>(m_policies));
+                }));
+      }
+    }
+
+    template <std::size_t... I>
+    std::tuple<std::decay_t<Args> const&...>
+        arguments([[maybe_unused]] std::size_t index, std::index_sequence<I...>) const
+    {
+      return {get<I>(index)...};
+    }
+
+    template <std::size_t... I>
+    std::tuple<matchable_t<Args> const&...>
+        matchable_arguments([[maybe_unused]] std::size_t index, std::index_sequence<I...>) const
+    {
+      return {with_stored<I>(index, [](auto const& stored) -> matchable_t<Args> const& {
+        return matchable<Args>(stored);
+      })...};
+    }
+
+    template <std::size_t... I>
+    bool has_values([[maybe_unused]] std::size_t index, std::index_sequence<I...>) const
+    {
+      return (... && with_stored<I>(index, [](auto const& stored) {
+                return has_value(stored);
+              }));
+    }
+
+    template <std::size_t... I, typename... FuncArgs>
+    void push_back(std::size_t order, std::index_sequence<I...>, FuncArgs&&... args)
+    {
+      if (m_layout == log_layout::rows)
+      {
+        m_invocations.push_back(
+            {std::tuple<stored_t<Args>...>(make_stored<Args>(
+                 std::forward<FuncArgs>(args), std::get<I>(m_policies))...),
+             order});
+      }
+      else
+      {
+        m_orders.push_back(order);
+        (...,
+         std::get<I>(m_columns)
+             .push_back(column_t<stored_t<Args>>{make_stored<Args>(
+                 std::forward<FuncArgs>(args), std::get<I>(m_policies))}));
+      }
+    }
+
+    // Interned values are compared by address, so a value matched against an argument
+    // that may be interned is replaced by its interned copy.
+    template <std::size_t I, typename Matcher>
+    decltype(auto) intern_matcher(Matcher const& matcher) const
+    {
+      using arg_type = std::decay_t<std::tuple_element_t<I, std::tuple<Args...>>>;
+      if constexpr (
+          is_captured<stored_t<arg_type>>::value && is_hashable_v<arg_type> &&
+          std::is_same_v<Matcher, arg_type>)
+      {
+        auto const& policy = std::get<I>(m_interns);
+        return interned_query<arg_type>{policy ? policy->find(matcher) : nullptr, &matcher};
+      }
+      else
+      {
+        return (matcher);
+      }
+    }
+
+    template <typename F, std::size_t... I, typename... Matchers>
+    decltype(auto)
+        with_interned(F&& f, std::index_sequence<I...>, Matchers const&... matchers) const
+    {
+      return f(intern_matcher<I>(matchers)...);
+    }
+
+    template <std::size_t... I>
+    void to_columns(std::index_sequence<I...>)
+    {
+      for (auto& invocation : m_invocations)
+      {
+        m_orders.push_back(invocation.order);
+        (..., std::get<I>(m_columns).push_back({std::move(std::get<I>(invocation.arguments))}));
+      }
+      m_invocations.clear();
+      m_invocations.shrink_to_fit();
+    }
+
+    template <std::size_t... I>
+    void to_rows(std::index_sequence<I...>)
+    {
+      for (std::size_t i = 0; i < m_orders.size(); ++i)
+      {
+        m_invocations.push_back(
+            {std::tuple<stored_t<Args>...>(
+                 from_column<stored_t<Args>>(std::move(std::get<I>(m_columns)[i]))...),
+             m_orders[i]});
+      }
+      m_orders.clear();
+      m_orders.shrink_to_fit();
+      (..., (std::get<I>(m_columns).clear(), std::get<I>(m_columns).shrink_to_fit()));
+    }
+
+  public:
+    log_layout layout() const
+    {
+      return m_layout;
+    }
+
+    // Changes the storage layout, converting the invocations recorded so far.
+    void layout(log_layout layout)
+    {
+      if (layout != m_layout)
+      {
+        if (layout == log_layout::columns)
+        {
+          to_columns(std::index_sequence_for<Args...>());
+        }
+        else
+        {
+          to_rows(std::index_sequence_for<Args...>());
+        }
+        m_layout = layout;
+      }
+    }
+
+    // Sets how argument `I` of calls recorded from now on is stored. Interned values are
+    // kept in `tables`, which are made if there are none.
+    template <std::size_t I, typename Policy>
+    void capture(Policy const& policy, std::shared_ptr<intern_tables>& tables)
+    {
+      using param_type = std::tuple_element_t<I, std::tuple<Args...>>;
+      static_assert(
+          is_captured<stored_t<param_type>>::value,
+          "capture policies apply to copyable arguments of class type");
+      auto& current = std::get<I>(m_policies) =
+          capture_policy_for<param_type, Policy>::make(policy, tables);
+      if (current)
+      {
+        if (current->interns())
+        {
+          std::get<I>(m_interns) = current;
+        }
+        m_kept_policies.push_back(current);
+      }
+    }
+
+    // Keeps a Bloom filter of `bits` bits over the recorded argument tuples, or none if
+    // `bits` is zero. Has no effect unless every argument type is hashable.
+    void filter(std::size_t bits)
+    {
+      if constexpr (is_filterable)
+      {
+        if (bits == 0)
+        {
+          m_filter.reset();
+        }
+        else if (!m_filter || m_filter->bits() != bloom_filter::round_bits(bits))
+        {
+          // Calls whose arguments were not captured cannot be added, and a filter
+          // missing any call could give false negatives, so it is only used once the
+          // log is cleared with `clear`.
+          m_filter.emplace(bits);
+          m_filter_complete = true;
+          for (std::size_t i = 0; i < size() && m_filter_complete; ++i)
+          {
+            if (has_values(i))
+            {
+              m_filter->insert(std::apply(
+                  [](auto const&... args) {
+                    return hash(args...);
+                  },
+                  arguments(i)));
+            }
+            else
+            {
+              m_filter_complete = false;
+            }
+          }
+        }
+      }
+    }
+
+    // False only if no recorded invocation has arguments equal to `matchers`. Without a
+    // filter, or when a matcher is not a value of its argument type, this is always true.
+    template <typename... Matchers>
+    bool might_contain(Matchers const&... matchers) const
+    {
+      if constexpr (
+          is_filterable && sizeof...(Matchers) == sizeof...(Args) &&
+          (... && std::is_same_v<Matchers, std::decay_t<Args>>))
+      {
+        return !m_filter || !m_filter_complete || m_filter_inexact ||
+            m_filter->might_contain(hash(matchers...));
+      }
+      else
+      {
+        return true;
+      }
+    }
+
+    // Calls `f` with `matchers`, where each value matched against an argument that may be
+    // interned is replaced by an `interned_query`, found in the intern table once.
+    template <typename F, typename... Matchers>
+    decltype(auto) with_interned(F&& f, Matchers const&... matchers) const
+    {
+      if constexpr (sizeof...(Matchers) == sizeof...(Args))
+      {
+        return with_interned(f, std::index_sequence_for<Args...>(), matchers...);
+      }
+      else
+      {
+        return f(matchers...);
+      }
+    }
+
+    // Records an invocation. Owned arguments are moved from `args`.
+    template <typename... FuncArgs>
+    void push_back(std::size_t order, FuncArgs&&... args)
+    {
+      if constexpr (is_filterable)
+      {
+        if (!m_filter_inexact)
+        {
+          m_filter_inexact = !std::apply(
+              [](auto const&... policies) {
+                return (... && (!policies || policies->is_exact()));
+              },
+              m_policies);
+        }
+      }
+      if (extends_run(order, std::index_sequence_for<Args...>(), args...))
+      {
+        extend_run();
+        return;
+      }
+      if constexpr (is_filterable)
+      {
+        if (m_filter)
+        {
+          m_filter->insert(hash(args...));
+        }
+      }
+      auto const index = size();
+      push_back(order, std::index_sequence_for<Args...>(), std::forward<FuncArgs>(args)...);
+      m_runs.push_back(index + 1);
+      if constexpr (is_spillable)
+      {
+        if (m_spill && resident_entries() >= m_spill_threshold)
+        {
+          spill(std::index_sequence_for<Args...>());
+        }
+      }
+    }
+
+    // Moves the recorded invocations to `file` whenever `threshold` of them are held in
+    // memory. Invocations already in another spill file are copied to the new one.
+    void spill(std::unique_ptr<spill_storage> file, std::size_t threshold)
+    {
+      static_assert(
+          is_spillable, "only invocations with arguments of scalar type can be spilled");
+      if (m_spill && m_spill->size() != 0)
+      {
+        std::memcpy(file->append(m_spill->size()), m_spill->data(), m_spill->size());
+      }
+      m_spill = std::move(file);
+      m_spill_threshold = std::max<std::size_t>(threshold, 1);
+      if (resident_entries() >= m_spill_threshold)
+      {
+        spill(std::index_sequence_for<Args...>());
+      }
+    }
+
+    // Whether `column<I>()` holds argument `I` of every call, by index.
+    bool has_columns() const
+    {
+      return m_layout == log_layout::columns && !m_runs.enabled() && m_spilled == 0;
+    }
+
+    // Merges later calls that continue the last run of identical calls into it: calls
+    // made one after another, with no call to another mocked function in between, whose
+    // arguments would be stored the same way.
+    void compress(bool enabled)
+    {
+      m_runs.compress(enabled, m_spilled, resident_entries());
+    }
+
+    // Whether the stored invocations may stand for runs of several calls.
+    bool has_runs() const
+    {
+      return m_runs.enabled();
+    }
+
+    // The indices [first, last) of the run of identical calls that includes `index`.
+    std::pair<std::size_t, std::size_t> run(std::size_t index) const
+    {
+      if (!m_runs.enabled())
+      {
+        return {index, index + 1};
+      }
+      auto const e = entry(index);
+      return {run_begin(e), run_end(e)};
+    }
+
+    // Argument `I` of the invocation at `index`, when the log owns it. Such logs are
+    // neither compressed nor spilled, so the index is that of the stored invocation.
+    template <std::size_t I>
+    auto& at(std::size_t index)
+    {
+      if (m_layout == log_layout::rows)
+      {
+        return std::get<I>(m_invocations[index].arguments);
+      }
+      return std::get<I>(m_columns)[index];
+    }
+
+    void clear()
+    {
+      if (m_filter)
+      {
+        m_filter->clear();
+        m_filter_complete = true;
+      }
+      m_filter_inexact = false;
+      m_invocations.clear();
+      m_orders.clear();
+      m_runs.clear();
+      m_spilled = 0;
+      if (m_spill)
+      {
+        m_spill->clear();
+      }
+      std::apply(
+          [](auto&... columns) {
+            (..., columns.clear());
+          },
+          m_columns);
+    }
+
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    // The number of calls recorded.
+    std::size_t size() const
+    {
+      if (m_runs.enabled())
+      {
+        return entries() == 0 ? 0 : run_end(entries() - 1);
+      }
+      return entries();
+    }
+
+    std::size_t order(std::size_t index) const
+    {
+      auto const e = entry(index);
+      return entry_order(e) + (index - run_begin(e));
+    }
+
+    template <std::size_t I>
+    decltype(auto) get(std::size_t index) const
+    {
+      using arg_type = std::tuple_element_t<I, std::tuple<Args...>>;
+      return with_stored<I>(index, [](auto const& stored) -> std::decay_t<arg_type> const& {
+        return unwrap<arg_type>(stored);
+      });
+    }
+
+    // The stored values of argument `I` held in memory, when the log uses the column
+    // layout. See `has_columns`.
+    template <std::size_t I>
+    auto const& column() const
+    {
+      return std::get<I>(m_columns);
+    }
+
+    std::tuple<std::decay_t<Args> const&...> arguments(std::size_t index) const
+    {
+      return arguments(index, std::index_sequence_for<Args...>());
+    }
+
+    // Whether every argument of the invocation at `index` can be read.
+    bool has_values(std::size_t index) const
+    {
+      return has_values(index, std::index_sequence_for<Args...>());
+    }
+
+    // Calls `f` with the arguments of the invocation at `index`, as `matchable_t`, so
+    // that arguments of class type are passed as captured.
+    template <typename F>
+    bool match(std::size_t index, F&& f) const
+    {
+      return std::apply(
+          std::forward<F>(f), matchable_arguments(index, std::index_sequence_for<Args...>()));
+    }
+
+    // The index of the first invocation with an order greater than `order`.
+    std::size_t upper_bound(std::size_t order) const
+    {
+      std::size_t first = 0;
+      std::size_t count = entries();
+      while (count > 0)
+      {
+        auto const step = count / 2;
+        if (entry_order(first + step) + run_length(first + step) - 1 <= order)
+        {
+          first += step + 1;
+          count -= step + 1;
+        }
+        else
+        {
+          count = step;
+        }
+      }
+      if (!m_runs.enabled() || first == entries())
+      {
+        return m_runs.enabled() ? size() : first;
+      }
+      auto const begin = entry_order(first);
+      return run_begin(first) + (order < begin ? 0 : order - begin + 1);
+    }
+
+    invocation_ref<Args...> operator[](std::size_t index) const
+    {
+      return {*this, index};
+    }
+  };
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_INVOCATION_LOG_HPP
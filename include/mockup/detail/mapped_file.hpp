@@ -0,0 +1,225 @@
+#ifndef MOCKUP_DETAIL_MAPPED_FILE_HPP
+#define MOCKUP_DETAIL_MAPPED_FILE_HPP
+
+#include <mockup/detail/spill_storage.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MOCKUP_DETAIL_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mockup::detail
+{
+  // A file on local disk mapped into memory and grown as data is appended. Its pages
+  // are written back by the system, so they need not stay resident. Unless it is kept,
+  // the file is removed when it is closed.
+  class mapped_file : public spill_storage
+  {
+  private:
+    std::string m_path;
+    bool m_keep = false;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = 0;
+    std::byte* m_data = nullptr;
+#if defined(MOCKUP_DETAIL_POSIX)
+    int m_fd = -1;
+
+    [[noreturn]] void fail(char const* what) const
+    {
+      throw std::system_error(errno, std::generic_category(), what + (": " + m_path));
+    }
+
+    void reserve(std::size_t capacity)
+    {
+      constexpr std::size_t minimum_capacity = std::size_t(1) << 20;
+      capacity = std::max({capacity, m_capacity * 2, minimum_capacity});
+      if (::ftruncate(m_fd, static_cast<off_t>(capacity)) != 0)
+      {
+        fail("cannot grow mapped file");
+      }
+      // The old mapping is kept until the new one is made, so that the data stays
+      // readable if mapping fails.
+      auto* data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+      if (data == MAP_FAILED)
+      {
+        fail("cannot map file");
+      }
+      if (m_data != nullptr)
+      {
+        ::munmap(m_data, m_capacity);
+      }
+      m_data = static_cast<std::byte*>(data);
+      m_capacity = capacity;
+    }
+#endif
+
+  public:
+    // Creates the file at `path`, replacing any existing file.
+    explicit mapped_file(std::string path, bool keep = false)
+    : m_path(std::move(path))
+    , m_keep(keep)
+    {
+#if defined(MOCKUP_DETAIL_POSIX)
+      m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+      if (m_fd < 0)
+      {
+        fail("cannot open mapped file");
+      }
+#else
+      throw std::system_error(
+          std::make_error_code(std::errc::function_not_supported), "mapped files");
+#endif
+    }
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    // Removes the file, or truncates it to the data appended if it is kept.
+    ~mapped_file() override
+    {
+#if defined(MOCKUP_DETAIL_POSIX)
+      if (m_data != nullptr)
+      {
+        ::munmap(m_data, m_capacity);
+      }
+      if (m_keep)
+      {
+        [[maybe_unused]] auto const result = ::ftruncate(m_fd, static_cast<off_t>(m_size));
+      }
+      else
+      {
+        ::unlink(m_path.c_str());
+      }
+      ::close(m_fd);
+#endif
+    }
+
+    std::string const& path() const
+    {
+      return m_path;
+    }
+
+    std::size_t size() const override
+    {
+      return m_size;
+    }
+
+    std::byte* data() override
+    {
+      return m_data;
+    }
+
+    std::byte const* data() const override
+    {
+      return m_data;
+    }
+
+    std::byte* append(std::size_t size) override
+    {
+#if defined(MOCKUP_DETAIL_POSIX)
+      if (m_size + size > m_capacity)
+      {
+        reserve(m_size + size);
+      }
+#endif
+      auto* result = m_data + m_size;
+      m_size += size;
+      return result;
+    }
+
+    void clear() override
+    {
+      m_size = 0;
+    }
+  };
+
+  // An existing file mapped read-only into memory. Its pages are read by the system as
+  // they are touched, so a file much larger than memory can be read at random.
+  class mapped_view
+  {
+  private:
+    std::string m_path;
+    std::size_t m_size = 0;
+    std::byte const* m_data = nullptr;
+
+  public:
+    explicit mapped_view(std::string path)
+    : m_path(std::move(path))
+    {
+#if defined(MOCKUP_DETAIL_POSIX)
+      auto const fd = ::open(m_path.c_str(), O_RDONLY);
+      if (fd < 0)
+      {
+        throw std::system_error(
+            errno, std::generic_category(), "cannot open mapped file: " + m_path);
+      }
+      struct stat status;
+      if (::fstat(fd, &status) != 0)
+      {
+        auto const error = errno;
+        ::close(fd);
+        throw std::system_error(
+            error, std::generic_category(), "cannot read mapped file: " + m_path);
+      }
+      m_size = static_cast<std::size_t>(status.st_size);
+      if (m_size != 0)
+      {
+        auto* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+          auto const error = errno;
+          ::close(fd);
+          throw std::system_error(error, std::generic_category(), "cannot map file: " + m_path);
+        }
+        m_data = static_cast<std::byte const*>(data);
+      }
+      // The mapping keeps the file open.
+      ::close(fd);
+#else
+      throw std::system_error(
+          std::make_error_code(std::errc::function_not_supported), "mapped files");
+#endif
+    }
+
+    mapped_view(mapped_view const&) = delete;
+    mapped_view& operator=(mapped_view const&) = delete;
+
+    ~mapped_view()
+    {
+#if defined(MOCKUP_DETAIL_POSIX)
+      if (m_data != nullptr)
+      {
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+      }
+#endif
+    }
+
+    std::string const& path() const
+    {
+      return m_path;
+    }
+
+    std::size_t size() const
+    {
+      return m_size;
+    }
+
+    std::byte const* data() const
+    {
+      return m_data;
+    }
+  };
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_MAPPED_FILE_HPP
@@ -0,0 +1,444 @@
+#ifndef MOCKUP_DETAIL_MEMBER_FUNCTION_HPP
+#define MOCKUP_DETAIL_MEMBER_FUNCTION_HPP
+
+#include <mockup/detail/class_instance.hpp>
+#include <mockup/detail/invocation_log.hpp>
+#include <mockup/detail/order.hpp>
+#include <mockup/error.hpp>
+#include <mockup/matchers.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mockup::detail
+{
+  // Actions receive arguments owned by the log by rvalue reference, so that an action
+  // only takes ownership from the log if it takes the argument by value.
+  template <typename Arg>
+  using action_argument_t = std::conditional_t<owns_argument_v<Arg>, Arg&&, Arg>;
+
+  template <typename>
+  struct action;
+
+  template <typename R, typename... Args>
+  struct action<R(Args...)>
+  {
+    std::function<bool(std::decay_t<Args> const&...)> match;
+    std::function<R(action_argument_t<Args>...)> function;
+
+    template <typename Arguments>
+    explicit action(
+        Arguments&& arguments, std::function<R(action_argument_t<Args>...)> function)
+    : match([arguments =
+                 std::forward<Arguments>(arguments)](std::decay_t<Args> const&... args) {
+      return arguments == std::tie(args...);
+    })
+    , function(std::move(function))
+    {
+    }
+  };
+
+  template <typename>
+  struct member_function_instance;
+
+  template <typename R, typename... Args>
+  struct member_function_instance<R(Args...)>
+  {
+    invocation_log<Args...> invocations;
+    std::vector<action<R(Args...)>> actions;
+    std::vector<std::function<void(std::size_t, std::decay_t<Args> const&...)>> observers;
+    // Observers that are dropped once they return false.
+    std::vector<std::function<bool(std::size_t, std::decay_t<Args> const&...)>>
+        transient_observers;
+    bool recording = true;
+    std::optional<bool> strict;
+    std::optional<std::size_t> filter_bits;
+    mock_settings const* settings = nullptr;
+
+    member_function_instance()
+    {
+      if constexpr (std::is_default_constructible_v<std::decay_t<R>>)
+      {
+        actions.emplace_back(helpers::wildcard, [r = std::decay_t<R>()](auto&&...) mutable -> R {
+          return std::forward<R>(r);
+        });
+      }
+    }
+
+    template <typename... FuncArgs>
+    R operator()(FuncArgs&&... args)
+    {
+      // A call rejected in strict mode is not observed, counted or recorded.
+      auto* const selected = select(args...);
+      if (!selected && strict.value_or(settings && settings->strict))
+      {
+        throw expectation_error("unexpected call to member function in strict mode");
+      }
+      auto const current = ++order;
+      for (auto it = transient_observers.begin(); it != transient_observers.end();)
+      {
+        it = (*it)(current, args...) ? std::next(it) : transient_observers.erase(it);
+      }
+      for (auto& observer : observers)
+      {
+        observer(current, args...);
+      }
+      if (recording)
+      {
+        invocations.filter(filter_bits.value_or(settings ? settings->filter_bits : 0));
+        invocations.push_back(current, std::forward<FuncArgs>(args)...);
+        if constexpr ((... || owns_argument_v<Args>))
+        {
+          return act_on_recorded(
+              selected,
+              current,
+              std::index_sequence_for<Args...>(),
+              std::forward<FuncArgs>(args)...);
+        }
+      }
+      return act(selected, std::forward<FuncArgs>(args)...);
+    }
+
+  private:
+    template <std::size_t I>
+    using argument_t = std::tuple_element_t<I, std::tuple<Args...>>;
+
+    template <std::size_t I>
+    static constexpr bool owns_v = owns_argument_v<argument_t<I>>;
+
+    template <std::size_t I>
+    using owned_t = std::conditional_t<owns_v<I>, std::decay_t<argument_t<I>>, std::tuple<>>;
+
+    // The arguments that the log owns, moved out of it while an action runs. The action
+    // may call the function again, which records another call and may move the storage
+    // of the log, so it is passed these instead. They are moved back, as the action left
+    // them, when it returns.
+    template <std::size_t... I>
+    class borrowed_arguments
+    {
+    private:
+      invocation_log<Args...>& m_log;
+      std::size_t m_index;
+      std::size_t m_order;
+      std::tuple<owned_t<I>...> m_values;
+
+    public:
+      borrowed_arguments(invocation_log<Args...>& log, std::size_t index, std::size_t order)
+      : m_log(log)
+      , m_index(index)
+      , m_order(order)
+      , m_values(take<I>(log, index)...)
+      {
+      }
+
+      borrowed_arguments(borrowed_arguments const&) = delete;
+      borrowed_arguments& operator=(borrowed_arguments const&) = delete;
+
+      ~borrowed_arguments()
+      {
+        // The action may have cleared the log.
+        if (m_index < m_log.size() && m_log.order(m_index) == m_order)
+        {
+          (..., restore<I>(m_log, m_index, std::get<I>(m_values)));
+        }
+      }
+
+      template <std::size_t J>
+      static owned_t<J> take(invocation_log<Args...>& log, std::size_t index)
+      {
+        if constexpr (owns_v<J>)
+        {
+          return std::move(log.template at<J>(index));
+        }
+        else
+        {
+          return {};
+        }
+      }
+
+      // Owned arguments need not be assignable, so each is constructed anew.
+      template <std::size_t J>
+      static void restore(invocation_log<Args...>& log, std::size_t index, owned_t<J>& value)
+      {
+        if constexpr (owns_v<J>)
+        {
+          using owned = owned_t<J>;
+          auto& stored = log.template at<J>(index);
+          stored.~owned();
+          new (&stored) owned(std::move(value));
+        }
+      }
+
+      template <std::size_t J, typename FuncArg>
+      decltype(auto) get(FuncArg&& arg)
+      {
+        if constexpr (owns_v<J>)
+        {
+          return std::move(std::get<J>(m_values));
+        }
+        else
+        {
+          return std::forward<FuncArg>(arg);
+        }
+      }
+    };
+
+    // The last action registered for arguments that match `args`, or null.
+    template <typename... FuncArgs>
+    action<R(Args...)>* select(FuncArgs const&... args)
+    {
+      constexpr bool has_default_action = std::is_default_constructible_v<std::decay_t<R>>;
+      auto const last = std::prev(std::rend(actions), has_default_action ? 1 : 0);
+      for (auto it = std::rbegin(actions); it != last; ++it)
+      {
+        if (it->match(args...))
+        {
+          return &*it;
+        }
+      }
+      return nullptr;
+    }
+
+    // Arguments moved into the log are passed on from there, or borrowed from it for a
+    // registered action.
+    template <std::size_t... I, typename... FuncArgs>
+    R act_on_recorded(
+        action<R(Args...)>* selected,
+        std::size_t current,
+        std::index_sequence<I...>,
+        FuncArgs&&... args)
+    {
+      auto const index = invocations.size() - 1;
+      if (selected)
+      {
+        borrowed_arguments<I...> borrowed(invocations, index, current);
+        return selected->function(
+            borrowed.template get<I>(std::forward<FuncArgs>(args))...);
+      }
+      return act(nullptr, recorded<I>(index, std::forward<FuncArgs>(args))...);
+    }
+
+    template <std::size_t I, typename FuncArg>
+    decltype(auto) recorded(std::size_t index, FuncArg&& arg)
+    {
+      if constexpr (owns_v<I>)
+      {
+        return std::move(invocations.template at<I>(index));
+      }
+      else
+      {
+        return std::forward<FuncArg>(arg);
+      }
+    }
+
+    template <typename... FuncArgs>
+    R act(action<R(Args...)>* selected, FuncArgs&&... args)
+    {
+      if (selected)
+      {
+        return selected->function(std::forward<FuncArgs>(args)...);
+      }
+      if constexpr (std::is_default_constructible_v<std::decay_t<R>>)
+      {
+        return actions.front().function(std::forward<FuncArgs>(args)...);
+      }
+      else if constexpr (!std::is_void_v<R>)
+      {
+        throw std::runtime_error(
+            "no action registered for member function with non-default constructible "
+            "return type");
+      }
+    }
+  };
+
+  template <
+      auto MemberFunction,
+      typename Mock,
+      typename MemberFunctionType = decltype(MemberFunction)>
+  struct member_function;
+
+  template <
+      typename Mock,
+      typename R,
+      typename T,
+      typename... Args,
+      R (T::*MemberFunction)(Args...) const>
+  struct member_function<MemberFunction, Mock, R (T::*)(Args...) const>
+  {
+    static std::map<Mock const*, member_function_instance<R(Args...)>> instances;
+  };
+
+  template <
+      typename Mock,
+      typename R,
+      typename T,
+      typename... Args,
+      R (T::*MemberFunction)(Args...) const>
+  std::map<Mock const*, member_function_instance<R(Args...)>>
+      member_function<MemberFunction, Mock, R (T::*)(Args...) const>::instances;
+
+  template <
+      typename Mock,
+      typename R,
+      typename T,
+      typename... Args,
+      R (T::*MemberFunction)(Args...)>
+  struct member_function<MemberFunction, Mock, R (T::*)(Args...)>
+  {
+    static std::map<Mock const*, member_function_instance<R(Args...)>> instances;
+  };
+
+  template <
+      typename Mock,
+      typename R,
+      typename T,
+      typename... Args,
+      R (T::*MemberFunction)(Args...)>
+  std::map<Mock const*, member_function_instance<R(Args...)>>
+      member_function<MemberFunction, Mock, R (T::*)(Args...)>::instances;
+
+  template <auto MemberFunction, typename = decltype(MemberFunction)>
+  struct member_function_class_type;
+
+  template <
+      typename R,
+      typename T,
+      typename... Args,
+      R (T::*MemberFunction)(Args...) const>
+  struct member_function_class_type<MemberFunction, R (T::*)(Args...) const>
+  {
+    using type = T;
+  };
+
+  template <typename R, typename T, typename... Args, R (T::*MemberFunction)(Args...)>
+  struct member_function_class_type<MemberFunction, R (T::*)(Args...)>
+  {
+    using type = T;
+  };
+
+  template <auto MemberFunction>
+  using member_function_class_type_t =
+      typename member_function_class_type<MemberFunction>::type;
+
+  template <typename Mock, typename = void>
+  struct has_inline_functions : std::false_type
+  {
+  };
+
+  template <typename Mock>
+  struct has_inline_functions<
+      Mock,
+      std::void_t<decltype(std::declval<Mock const&>().mockup_functions.settings())>>
+  : std::true_type
+  {
+  };
+
+  template <typename Mock>
+  mock_settings& get_mock_settings(Mock const* mock)
+  {
+    if constexpr (has_inline_functions<Mock>::value)
+    {
+      return mock->mockup_functions.settings();
+    }
+    else
+    {
+      return get_class_instance(mock).settings;
+    }
+  }
+
+  template <auto MemberFunction, typename Mock>
+  auto& get_registered_member_function_instance(Mock const* mock)
+  {
+    auto& instances =
+        member_function<MemberFunction, member_function_class_type_t<MemberFunction>>::
+            instances;
+    auto it = instances.find(mock);
+    if (it == instances.end())
+    {
+      it = instances
+               .emplace(
+                   std::piecewise_construct,
+                   std::forward_as_tuple(mock),
+                   std::forward_as_tuple())
+               .first;
+      get_class_instance(mock).destructors.push_back([&, mock]() {
+        instances.erase(mock);
+      });
+      it->second.settings = &get_mock_settings(mock);
+    }
+    return it->second;
+  }
+
+  template <auto MemberFunction, typename = decltype(MemberFunction)>
+  struct member_function_signature;
+
+  template <
+      typename R,
+      typename T,
+      typename... Args,
+      R (T::*MemberFunction)(Args...) const>
+  struct member_function_signature<MemberFunction, R (T::*)(Args...) const>
+  {
+    using type = R(Args...);
+  };
+
+  template <typename R, typename T, typename... Args, R (T::*MemberFunction)(Args...)>
+  struct member_function_signature<MemberFunction, R (T::*)(Args...)>
+  {
+    using type = R(Args...);
+  };
+
+  template <auto MemberFunction>
+  using member_function_signature_t =
+      typename member_function_signature<MemberFunction>::type;
+
+  // Arguments that cannot be copied must either be owned by the log or be passed with
+  // `ref()`, whose wrapper is copyable.
+  template <typename Signature, typename... Args>
+  struct is_recordable;
+
+  template <typename R, typename... Params, typename... Args>
+  struct is_recordable<R(Params...), Args...>
+  : std::bool_constant<(
+        ... && (std::is_copy_constructible_v<std::decay_t<Args>> || owns_argument_v<Params>))>
+  {
+  };
+
+  template <auto MemberFunction, typename Mock, typename = void>
+  struct has_inline_member_function_instance : std::false_type
+  {
+  };
+
+  template <auto MemberFunction, typename Mock>
+  struct has_inline_member_function_instance<
+      MemberFunction,
+      Mock,
+      std::enable_if_t<decltype(std::declval<Mock const&>().mockup_functions)::
+                           template contains<MemberFunction>>> : std::true_type
+  {
+  };
+
+  template <auto MemberFunction, typename Mock>
+  auto& get_member_function_instance(Mock const* mock)
+  {
+    if constexpr (has_inline_member_function_instance<MemberFunction, Mock>::value)
+    {
+      return mock->mockup_functions.template get<MemberFunction>();
+    }
+    else
+    {
+      return get_registered_member_function_instance<MemberFunction>(mock);
+    }
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_MEMBER_FUNCTION_HPP
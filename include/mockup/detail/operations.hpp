@@ -0,0 +1,111 @@
+#ifndef MOCKUP_DETAIL_OPERATIONS_HPP
+#define MOCKUP_DETAIL_OPERATIONS_HPP
+
+#include <mockup/detail/member_function.hpp>
+#include <mockup/detail/scan.hpp>
+#include <mockup/sequence.hpp>
+
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace mockup::detail
+{
+  template <typename Instance, typename... Args>
+  auto when(Instance& instance, Args&&... args)
+  {
+    return [&, args = std::make_tuple(std::forward<Args>(args)...)](
+               auto&& function) mutable {
+      using function_type = decltype(instance.actions.front().function);
+      static_assert(
+          std::is_constructible_v<function_type, decltype(function)>,
+          "function object cannot be called with the arguments of the member function");
+      instance.actions.emplace_back(
+          std::move(args), std::forward<decltype(function)>(function));
+    };
+  }
+
+  constexpr auto end_of_order = std::numeric_limits<std::size_t>::max();
+
+  // The indices of the recorded invocations with orders in (first, last]. The log is
+  // sorted by order, so the slice is found by binary search.
+  template <typename Instance>
+  std::pair<std::size_t, std::size_t>
+      invocations_between(Instance const& instance, std::size_t first, std::size_t last)
+  {
+    auto const begin = instance.invocations.upper_bound(first);
+    auto const end = instance.invocations.upper_bound(last);
+    return {begin, end < begin ? begin : end};
+  }
+
+  template <typename Instance, typename... Args>
+  bool invoked_between(
+      Instance const& instance, std::size_t first, std::size_t last, Args const&... args)
+  {
+    if (!instance.invocations.might_contain(args...))
+    {
+      return false;
+    }
+    auto const [begin, end] = invocations_between(instance, first, last);
+    return instance.invocations.with_interned(
+        [&, begin = begin, end = end](auto const&... matchers) {
+          return find_matches(
+              instance.invocations,
+              begin,
+              end,
+              [](std::size_t) {
+                return true;
+              },
+              matchers...);
+        },
+        args...);
+  }
+
+  template <typename Instance, typename... Args>
+  std::size_t times_between(
+      Instance const& instance, std::size_t first, std::size_t last, Args const&... args)
+  {
+    if (!instance.invocations.might_contain(args...))
+    {
+      return 0;
+    }
+    auto const [begin, end] = invocations_between(instance, first, last);
+    return instance.invocations.with_interned(
+        [&, begin = begin, end = end](auto const&... matchers) {
+          return count_matches(instance.invocations, begin, end, matchers...);
+        },
+        args...);
+  }
+
+  template <typename Instance, typename... Args>
+  bool invoked(Instance const& instance, Args const&... args)
+  {
+    return invoked_between(instance, 0, end_of_order, args...);
+  }
+
+  template <typename Instance, typename... Args>
+  bool invoked(Instance const& instance, sequence& seq, Args const&... args)
+  {
+    if (!instance.invocations.might_contain(args...))
+    {
+      return false;
+    }
+    auto const [begin, end] = invocations_between(instance, seq.order, end_of_order);
+    return instance.invocations.with_interned(
+        [&, begin = begin, end = end](auto const&... matchers) {
+          return find_matches(
+              instance.invocations,
+              begin,
+              end,
+              [&](std::size_t i) {
+                seq.order = instance.invocations.order(i);
+                return true;
+              },
+              matchers...);
+        },
+        args...);
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_OPERATIONS_HPP
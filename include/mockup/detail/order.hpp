@@ -0,0 +1,12 @@
+#ifndef MOCKUP_DETAIL_ORDER_HPP
+#define MOCKUP_DETAIL_ORDER_HPP
+
+#include <cstddef>
+
+namespace mockup::detail
+{
+  // The order of the most recent call to any mocked function.
+  inline std::size_t order = 0;
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_ORDER_HPP
@@ -0,0 +1,97 @@
+#ifndef MOCKUP_DETAIL_RUN_INDEX_HPP
+#define MOCKUP_DETAIL_RUN_INDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace mockup::detail
+{
+  // The runs of identical calls of a compressed log, each stored as one invocation. A
+  // call is indexed by its position among all the calls, and each run ends one past the
+  // index of its last call. Only the ends of the runs held in memory are kept here; a
+  // spilled invocation stores its own.
+  class run_index
+  {
+  private:
+    bool m_enabled = false;
+    bool m_compress = false;
+    std::vector<std::size_t> m_ends;
+
+  public:
+    // Whether stored invocations may stand for runs of several calls.
+    bool enabled() const
+    {
+      return m_enabled;
+    }
+
+    // Whether calls are merged into the last run.
+    bool compressing() const
+    {
+      return m_compress;
+    }
+
+    // Starts or stops merging calls. The first time, each of the `resident` invocations
+    // held in memory, after the `spilled` ones, becomes a run of one call.
+    void compress(bool enabled, std::size_t spilled, std::size_t resident)
+    {
+      if (enabled && !m_enabled)
+      {
+        m_ends.resize(resident);
+        for (std::size_t i = 0; i < resident; ++i)
+        {
+          m_ends[i] = spilled + i + 1;
+        }
+        m_enabled = true;
+      }
+      m_compress = enabled;
+    }
+
+    // The end of the run of the invocation `entry` among those held in memory.
+    std::size_t end(std::size_t entry) const
+    {
+      return m_ends[entry];
+    }
+
+    void push_back(std::size_t end)
+    {
+      if (m_enabled)
+      {
+        m_ends.push_back(end);
+      }
+    }
+
+    void extend()
+    {
+      ++m_ends.back();
+    }
+
+    void clear()
+    {
+      m_ends.clear();
+    }
+  };
+
+  // The first of `count` runs that ends after the call at `index`, where `end(i)` is the
+  // end of run `i`.
+  template <typename End>
+  std::size_t find_run(std::size_t count, std::size_t index, End const& end)
+  {
+    std::size_t first = 0;
+    while (count > 0)
+    {
+      auto const step = count / 2;
+      if (end(first + step) <= index)
+      {
+        first += step + 1;
+        count -= step + 1;
+      }
+      else
+      {
+        count = step;
+      }
+    }
+    return first;
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_RUN_INDEX_HPP
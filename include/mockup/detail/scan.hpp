@@ -0,0 +1,235 @@
+#ifndef MOCKUP_DETAIL_SCAN_HPP
+#define MOCKUP_DETAIL_SCAN_HPP
+
+#include <mockup/detail/compare.hpp>
+#include <mockup/detail/simd.hpp>
+#include <mockup/layout.hpp>
+#include <mockup/matchers.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace mockup::detail
+{
+  // How a query evaluates one matcher against a log in the column layout: not at all,
+  // a block of arguments at a time, or once per candidate invocation.
+  enum class matcher_kind
+  {
+    wildcard,
+    column,
+    row
+  };
+
+  template <typename Column, typename Matcher>
+  constexpr matcher_kind kind_of()
+  {
+    if constexpr (std::is_same_v<Matcher, wildcard_t>)
+    {
+      return matcher_kind::wildcard;
+    }
+    else if constexpr (!std::is_arithmetic_v<Column>)
+    {
+      return matcher_kind::row;
+    }
+    else if constexpr (std::is_arithmetic_v<Matcher>)
+    {
+      return matcher_kind::column;
+    }
+    else if constexpr (compare_matcher<Matcher>::value)
+    {
+      return std::is_arithmetic_v<typename compare_matcher<Matcher>::type> ? matcher_kind::column
+                                                                             : matcher_kind::row;
+    }
+    else
+    {
+      return matcher_kind::row;
+    }
+  }
+
+  template <typename Log, std::size_t I>
+  using column_value_t =
+      typename std::decay_t<decltype(std::declval<Log const&>().template column<I>())>::value_type;
+
+  template <typename Log, typename... Matchers, std::size_t... I>
+  constexpr bool has_kind([[maybe_unused]] matcher_kind kind, std::index_sequence<I...>)
+  {
+    return (... || (kind_of<column_value_t<Log, I>, Matchers>() == kind));
+  }
+
+  template <typename Log, typename... Matchers>
+  constexpr bool has_column_kind_v = has_kind<Log, Matchers...>(
+      matcher_kind::column, std::index_sequence_for<Matchers...>());
+
+  template <typename Log, typename... Matchers>
+  constexpr bool has_row_kind_v =
+      has_kind<Log, Matchers...>(matcher_kind::row, std::index_sequence_for<Matchers...>());
+
+  template <std::size_t I, typename Log, typename Matcher>
+  std::uint64_t column_mask(
+      Log const& log, std::size_t begin, std::size_t size, Matcher const& matcher)
+  {
+    if constexpr (kind_of<column_value_t<Log, I>, Matcher>() != matcher_kind::column)
+    {
+      return ~std::uint64_t(0);
+    }
+    else
+    {
+      auto const* data = log.template column<I>().data() + begin;
+      if constexpr (std::is_arithmetic_v<Matcher>)
+      {
+        return match_block<equal>(data, size, matcher);
+      }
+      else
+      {
+        return match_block<typename compare_matcher<Matcher>::op>(
+            data, size, predicate_access::get(matcher).value);
+      }
+    }
+  }
+
+  // One bit per invocation in [begin, begin + size), set where every column-evaluated
+  // matcher holds.
+  template <typename Log, std::size_t... I, typename... Matchers>
+  std::uint64_t block_mask(
+      Log const& log,
+      std::size_t begin,
+      std::size_t size,
+      std::index_sequence<I...>,
+      Matchers const&... matchers)
+  {
+    return (first_bits(size) & ... & column_mask<I>(log, begin, size, matchers));
+  }
+
+  // Calls `visit` with the index of each invocation in [begin, end) whose arguments
+  // match, in order, until it returns true. Returns whether `visit` stopped the scan.
+  // When the log uses the column layout, comparisons of arithmetic arguments are made
+  // for a block of invocations at once, and only the invocations that pass them are
+  // checked against the remaining matchers.
+  template <typename Log, typename Visit, typename... Matchers>
+  bool find_matches(
+      Log const& log,
+      std::size_t begin,
+      std::size_t end,
+      Visit&& visit,
+      Matchers const&... matchers)
+  {
+    auto matches = [expected = std::tie(matchers...)](auto const&... args) {
+      return expected == std::tie(args...);
+    };
+    if (log.has_runs())
+    {
+      // The calls of a run are identical, so they are matched once.
+      for (auto i = begin; i != end;)
+      {
+        auto const run_end = std::min(log.run(i).second, end);
+        if (log.match(i, matches))
+        {
+          for (; i != run_end; ++i)
+          {
+            if (visit(i))
+            {
+              return true;
+            }
+          }
+        }
+        i = run_end;
+      }
+      return false;
+    }
+    if constexpr (has_column_kind_v<Log, Matchers...>)
+    {
+      if (log.has_columns())
+      {
+        for (auto block = begin; block < end; block += block_size)
+        {
+          auto mask = block_mask(
+              log,
+              block,
+              std::min(block_size, end - block),
+              std::index_sequence_for<Matchers...>(),
+              matchers...);
+          for (; mask != 0; mask &= mask - 1)
+          {
+            auto const i = block + count_trailing_zeros(mask);
+            if constexpr (has_row_kind_v<Log, Matchers...>)
+            {
+              if (!log.match(i, matches))
+              {
+                continue;
+              }
+            }
+            if (visit(i))
+            {
+              return true;
+            }
+          }
+        }
+        return false;
+      }
+    }
+    for (auto i = begin; i != end; ++i)
+    {
+      if (log.match(i, matches) && visit(i))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename Log, typename... Matchers>
+  std::size_t count_matches(
+      Log const& log, std::size_t begin, std::size_t end, Matchers const&... matchers)
+  {
+    std::size_t count = 0;
+    if (log.has_runs())
+    {
+      auto matches = [expected = std::tie(matchers...)](auto const&... args) {
+        return expected == std::tie(args...);
+      };
+      for (auto i = begin; i != end;)
+      {
+        auto const run_end = std::min(log.run(i).second, end);
+        if (log.match(i, matches))
+        {
+          count += run_end - i;
+        }
+        i = run_end;
+      }
+      return count;
+    }
+    if constexpr (
+        has_column_kind_v<Log, Matchers...> && !has_row_kind_v<Log, Matchers...>)
+    {
+      if (log.has_columns())
+      {
+        for (auto block = begin; block < end; block += block_size)
+        {
+          count += count_ones(block_mask(
+              log,
+              block,
+              std::min(block_size, end - block),
+              std::index_sequence_for<Matchers...>(),
+              matchers...));
+        }
+        return count;
+      }
+    }
+    find_matches(
+        log,
+        begin,
+        end,
+        [&](std::size_t) {
+          ++count;
+          return false;
+        },
+        matchers...);
+    return count;
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_SCAN_HPP
@@ -0,0 +1,303 @@
+#ifndef MOCKUP_DETAIL_SIMD_HPP
+#define MOCKUP_DETAIL_SIMD_HPP
+
+#include <mockup/detail/compare.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Vector kernels are chosen at compile time from the target instruction set. Define
+// MOCKUP_NO_SIMD to use the scalar kernels only.
+#if !defined(MOCKUP_NO_SIMD) && defined(__AVX2__)
+#define MOCKUP_DETAIL_AVX2
+#include <immintrin.h>
+#elif !defined(MOCKUP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define MOCKUP_DETAIL_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace mockup::detail
+{
+  // The number of bits in a block mask, and so the number of column elements compared
+  // by one call to `match_block`.
+  constexpr std::size_t block_size = 64;
+
+  inline std::size_t count_trailing_zeros(std::uint64_t mask)
+  {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(mask));
+#else
+    std::size_t count = 0;
+    for (; (mask & 1) == 0; mask >>= 1)
+    {
+      ++count;
+    }
+    return count;
+#endif
+  }
+
+  inline std::size_t count_ones(std::uint64_t mask)
+  {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_popcountll(mask));
+#else
+    std::size_t count = 0;
+    for (; mask != 0; mask &= mask - 1)
+    {
+      ++count;
+    }
+    return count;
+#endif
+  }
+
+  inline std::uint64_t first_bits(std::size_t count)
+  {
+    return count == block_size ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+  }
+
+  // Integer kernels only have equality and greater-than comparisons. The remaining
+  // operations swap the operands or negate the result.
+  template <typename Op>
+  constexpr bool is_negated_v =
+      std::is_same_v<Op, not_equal> || std::is_same_v<Op, less_equal> ||
+      std::is_same_v<Op, greater_equal>;
+
+  template <typename Op>
+  constexpr bool is_swapped_v = std::is_same_v<Op, less> || std::is_same_v<Op, greater_equal>;
+
+  // Compares `lanes` consecutive elements with one vector operation and returns one bit
+  // per element. Types without a specialization have no vector kernel.
+  template <typename T>
+  struct simd
+  {
+    static constexpr std::size_t lanes = 0;
+  };
+
+#if defined(MOCKUP_DETAIL_AVX2)
+  template <>
+  struct simd<std::int32_t>
+  {
+    static constexpr std::size_t lanes = 8;
+
+    template <typename Op>
+    static unsigned compare(std::int32_t const* data, std::int32_t value)
+    {
+      auto const x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data));
+      auto const y = _mm256_set1_epi32(value);
+      __m256i result;
+      if constexpr (std::is_same_v<Op, equal> || std::is_same_v<Op, not_equal>)
+      {
+        result = _mm256_cmpeq_epi32(x, y);
+      }
+      else if constexpr (is_swapped_v<Op>)
+      {
+        result = _mm256_cmpgt_epi32(y, x);
+      }
+      else
+      {
+        result = _mm256_cmpgt_epi32(x, y);
+      }
+      auto const mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(result)));
+      return is_negated_v<Op> ? mask ^ 0xffu : mask;
+    }
+  };
+
+  template <>
+  struct simd<std::int64_t>
+  {
+    static constexpr std::size_t lanes = 4;
+
+    template <typename Op>
+    static unsigned compare(std::int64_t const* data, std::int64_t value)
+    {
+      auto const x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data));
+      auto const y = _mm256_set1_epi64x(value);
+      __m256i result;
+      if constexpr (std::is_same_v<Op, equal> || std::is_same_v<Op, not_equal>)
+      {
+        result = _mm256_cmpeq_epi64(x, y);
+      }
+      else if constexpr (is_swapped_v<Op>)
+      {
+        result = _mm256_cmpgt_epi64(y, x);
+      }
+      else
+      {
+        result = _mm256_cmpgt_epi64(x, y);
+      }
+      auto const mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(result)));
+      return is_negated_v<Op> ? mask ^ 0xfu : mask;
+    }
+  };
+
+  // Floating-point comparisons are ordered, except inequality, so that NaN behaves as it
+  // does with the built-in operators.
+  template <typename Op>
+  constexpr int avx_predicate_v = std::is_same_v<Op, equal>       ? _CMP_EQ_OQ
+                                  : std::is_same_v<Op, not_equal>  ? _CMP_NEQ_UQ
+                                  : std::is_same_v<Op, less>       ? _CMP_LT_OQ
+                                  : std::is_same_v<Op, less_equal> ? _CMP_LE_OQ
+                                  : std::is_same_v<Op, greater>    ? _CMP_GT_OQ
+                                                                   : _CMP_GE_OQ;
+
+  template <>
+  struct simd<float>
+  {
+    static constexpr std::size_t lanes = 8;
+
+    template <typename Op>
+    static unsigned compare(float const* data, float value)
+    {
+      auto const result =
+          _mm256_cmp_ps(_mm256_loadu_ps(data), _mm256_set1_ps(value), avx_predicate_v<Op>);
+      return static_cast<unsigned>(_mm256_movemask_ps(result));
+    }
+  };
+
+  template <>
+  struct simd<double>
+  {
+    static constexpr std::size_t lanes = 4;
+
+    template <typename Op>
+    static unsigned compare(double const* data, double value)
+    {
+      auto const result =
+          _mm256_cmp_pd(_mm256_loadu_pd(data), _mm256_set1_pd(value), avx_predicate_v<Op>);
+      return static_cast<unsigned>(_mm256_movemask_pd(result));
+    }
+  };
+#elif defined(MOCKUP_DETAIL_SSE2)
+  template <>
+  struct simd<std::int32_t>
+  {
+    static constexpr std::size_t lanes = 4;
+
+    template <typename Op>
+    static unsigned compare(std::int32_t const* data, std::int32_t value)
+    {
+      auto const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+      auto const y = _mm_set1_epi32(value);
+      __m128i result;
+      if constexpr (std::is_same_v<Op, equal> || std::is_same_v<Op, not_equal>)
+      {
+        result = _mm_cmpeq_epi32(x, y);
+      }
+      else if constexpr (is_swapped_v<Op>)
+      {
+        result = _mm_cmpgt_epi32(y, x);
+      }
+      else
+      {
+        result = _mm_cmpgt_epi32(x, y);
+      }
+      auto const mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(result)));
+      return is_negated_v<Op> ? mask ^ 0xfu : mask;
+    }
+  };
+
+  template <>
+  struct simd<float>
+  {
+    static constexpr std::size_t lanes = 4;
+
+    template <typename Op>
+    static unsigned compare(float const* data, float value)
+    {
+      auto const x = _mm_loadu_ps(data);
+      auto const y = _mm_set1_ps(value);
+      __m128 result;
+      if constexpr (std::is_same_v<Op, equal>)
+      {
+        result = _mm_cmpeq_ps(x, y);
+      }
+      else if constexpr (std::is_same_v<Op, not_equal>)
+      {
+        result = _mm_cmpneq_ps(x, y);
+      }
+      else if constexpr (std::is_same_v<Op, less>)
+      {
+        result = _mm_cmplt_ps(x, y);
+      }
+      else if constexpr (std::is_same_v<Op, less_equal>)
+      {
+        result = _mm_cmple_ps(x, y);
+      }
+      else if constexpr (std::is_same_v<Op, greater>)
+      {
+        result = _mm_cmpgt_ps(x, y);
+      }
+      else
+      {
+        result = _mm_cmpge_ps(x, y);
+      }
+      return static_cast<unsigned>(_mm_movemask_ps(result));
+    }
+  };
+
+  template <>
+  struct simd<double>
+  {
+    static constexpr std::size_t lanes = 2;
+
+    template <typename Op>
+    static unsigned compare(double const* data, double value)
+    {
+      auto const x = _mm_loadu_pd(data);
+      auto const y = _mm_set1_pd(value);
+      __m128d result;
+      if constexpr (std::is_same_v<Op, equal>)
+      {
+        result = _mm_cmpeq_pd(x, y);
+      }
+      else if constexpr (std::is_same_v<Op, not_equal>)
+      {
+        result = _mm_cmpneq_pd(x, y);
+      }
+      else if constexpr (std::is_same_v<Op, less>)
+      {
+        result = _mm_cmplt_pd(x, y);
+      }
+      else if constexpr (std::is_same_v<Op, less_equal>)
+      {
+        result = _mm_cmple_pd(x, y);
+      }
+      else if constexpr (std::is_same_v<Op, greater>)
+      {
+        result = _mm_cmpgt_pd(x, y);
+      }
+      else
+      {
+        result = _mm_cmpge_pd(x, y);
+      }
+      return static_cast<unsigned>(_mm_movemask_pd(result));
+    }
+  };
+#endif
+
+  // Compares up to `block_size` elements of a column with `value` and returns one bit per
+  // element, set where the comparison holds. Vector kernels are used when the column and
+  // the operand have the same type; other arithmetic types are compared one at a time,
+  // with the same conversions as the built-in operators.
+  template <typename Op, typename T, typename U>
+  std::uint64_t match_block(T const* data, std::size_t size, U const& value)
+  {
+    std::uint64_t mask = 0;
+    std::size_t i = 0;
+    if constexpr (std::is_same_v<T, U> && simd<T>::lanes != 0)
+    {
+      for (; i + simd<T>::lanes <= size; i += simd<T>::lanes)
+      {
+        mask |= std::uint64_t(simd<T>::template compare<Op>(data + i, value)) << i;
+      }
+    }
+    for (; i < size; ++i)
+    {
+      mask |= std::uint64_t(Op::apply(data[i], value)) << i;
+    }
+    return mask;
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_SIMD_HPP
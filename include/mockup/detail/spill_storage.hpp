@@ -0,0 +1,68 @@
+#ifndef MOCKUP_DETAIL_SPILL_STORAGE_HPP
+#define MOCKUP_DETAIL_SPILL_STORAGE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace mockup::detail
+{
+  // Records of fields of trivially copyable types, each at a fixed offset aligned for
+  // its type, so that a field can be read in place.
+  template <typename... Ts>
+  struct record_layout
+  {
+    static_assert(
+        (... && std::is_trivially_copyable_v<Ts>), "record fields must be trivially copyable");
+
+    static constexpr std::size_t alignment = std::max({alignof(Ts)...});
+
+    // The offset of each field, followed by the size of a record.
+    static constexpr std::array<std::size_t, sizeof...(Ts) + 1> offsets = [] {
+      std::array<std::size_t, sizeof...(Ts) + 1> result{};
+      std::array<std::size_t, sizeof...(Ts)> sizes{sizeof(Ts)...};
+      std::array<std::size_t, sizeof...(Ts)> alignments{alignof(Ts)...};
+      std::size_t offset = 0;
+      for (std::size_t i = 0; i < sizeof...(Ts); ++i)
+      {
+        offset = (offset + alignments[i] - 1) / alignments[i] * alignments[i];
+        result[i] = offset;
+        offset += sizes[i];
+      }
+      result[sizeof...(Ts)] = (offset + alignment - 1) / alignment * alignment;
+      return result;
+    }();
+
+    static constexpr std::size_t size = offsets[sizeof...(Ts)];
+  };
+
+  // Where an invocation log spills its records. Logs only see this interface, so that
+  // the file backend is compiled only where `<mockup/spill.hpp>` is included.
+  class spill_storage
+  {
+  public:
+    virtual ~spill_storage() = default;
+
+    virtual std::size_t size() const = 0;
+
+    virtual std::byte* data() = 0;
+
+    virtual std::byte const* data() const = 0;
+
+    // Extends the storage by `size` bytes and returns their address, which stays valid
+    // until the next call.
+    virtual std::byte* append(std::size_t size) = 0;
+
+    virtual void clear() = 0;
+  };
+
+  // Opens the storage for spilling to the file at `path`. Defined in
+  // `<mockup/spill.hpp>`; the parameter only defers the lookup until `spill` is used.
+  template <typename>
+  struct spill_file;
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_SPILL_STORAGE_HPP
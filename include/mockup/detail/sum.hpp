@@ -0,0 +1,34 @@
+#ifndef MOCKUP_DETAIL_SUM_HPP
+#define MOCKUP_DETAIL_SUM_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace mockup::detail
+{
+  template <typename T, typename = void>
+  struct sum_type
+  {
+    using type = decltype(std::declval<T const&>() + std::declval<T const&>());
+  };
+
+  // Integers are summed in the widest type of their signedness, so that totals of many
+  // `int` arguments do not overflow, and floating-point values in at least `double`.
+  template <typename T>
+  struct sum_type<T, std::enable_if_t<std::is_integral_v<T>>>
+  {
+    using type = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+  };
+
+  template <typename T>
+  struct sum_type<T, std::enable_if_t<std::is_floating_point_v<T>>>
+  {
+    using type = std::common_type_t<T, double>;
+  };
+
+  // The type in which arguments of type `T` are summed.
+  template <typename T>
+  using sum_t = typename sum_type<T>::type;
+} // namespace mockup::detail
+
+#endif // MOCKUP_DETAIL_SUM_HPP
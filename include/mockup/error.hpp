@@ -0,0 +1,18 @@
+#ifndef MOCKUP_ERROR_HPP
+#define MOCKUP_ERROR_HPP
+
+#include <mockup/fwd.hpp>
+
+#include <stdexcept>
+
+namespace mockup
+{
+  // Thrown from inside a mocked call that breaks an expectation.
+  class expectation_error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+} // namespace mockup
+
+#endif // MOCKUP_ERROR_HPP
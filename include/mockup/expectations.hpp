@@ -0,0 +1,194 @@
+#ifndef MOCKUP_EXPECTATIONS_HPP
+#define MOCKUP_EXPECTATIONS_HPP
+
+#include <mockup/error.hpp>
+#include <mockup/fwd.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mockup::detail
+{
+  // A step of an expected sequence: the function it expects a call to, and a matcher of
+  // the arguments of that function.
+  struct expected_step
+  {
+    void const* function;
+    std::shared_ptr<void const> matcher;
+  };
+
+  struct expected_sequence_state
+  {
+    std::vector<expected_step> steps;
+    std::size_t next = 0;
+    std::size_t order = 0;
+    // The functions that have an observer for the sequence, each with a token held by
+    // its observer, so that a function whose observer was dropped is observed again.
+    std::vector<std::pair<void const*, std::weak_ptr<void const>>> observed;
+  };
+
+  struct expectation_state
+  {
+    std::size_t count = 0;
+    std::size_t min = 0;
+    std::size_t max = std::numeric_limits<std::size_t>::max();
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // An ordered list of expected calls that is checked as the calls are made. Each
+  // member function with steps has one observer, which advances the sequence when the
+  // next step is a call to that function and the call matches. Each call therefore
+  // costs constant time, checking the sequence afterwards is O(1), and it works with
+  // recording disabled. The observers are dropped once the sequence is satisfied, or
+  // at their next call once it is destroyed.
+  class expected_sequence
+  {
+  private:
+    std::shared_ptr<detail::expected_sequence_state> m_state =
+        std::make_shared<detail::expected_sequence_state>();
+
+    template <typename Instance, typename... Args>
+    friend void detail::expect(Instance&, expected_sequence&, Args&&...);
+
+  public:
+    bool satisfied() const
+    {
+      return m_state->next == m_state->steps.size();
+    }
+
+    std::size_t remaining() const
+    {
+      return m_state->steps.size() - m_state->next;
+    }
+  };
+
+  // The number of times matching calls are expected. Exceeding the maximum throws
+  // expectation_error from the offending call, before it is recorded; falling short of
+  // the minimum can only be detected afterwards with satisfied().
+  class expectation
+  {
+  private:
+    std::shared_ptr<detail::expectation_state> m_state;
+
+  public:
+    explicit expectation(std::shared_ptr<detail::expectation_state> state)
+    : m_state(std::move(state))
+    {
+    }
+
+    expectation& times(std::size_t n)
+    {
+      m_state->min = n;
+      m_state->max = n;
+      return *this;
+    }
+
+    expectation& at_least(std::size_t n)
+    {
+      m_state->min = n;
+      return *this;
+    }
+
+    expectation& at_most(std::size_t n)
+    {
+      m_state->max = n;
+      return *this;
+    }
+
+    expectation& never()
+    {
+      return times(0);
+    }
+
+    std::size_t count() const
+    {
+      return m_state->count;
+    }
+
+    bool satisfied() const
+    {
+      return m_state->min <= m_state->count && m_state->count <= m_state->max;
+    }
+  };
+} // namespace mockup
+
+namespace mockup::detail
+{
+  template <typename Instance, typename... Args>
+  void expect(Instance& instance, expected_sequence& seq, Args&&... args)
+  {
+    using matcher = decltype(instance.actions.front().match);
+    auto const& state = seq.m_state;
+    state->steps.push_back(
+        {&instance,
+         std::make_shared<matcher const>(
+             [expected = std::make_tuple(std::forward<Args>(args)...)](auto const&... args) {
+               return expected == std::tie(args...);
+             })});
+
+    auto& observed = state->observed;
+    auto const it = std::find_if(observed.begin(), observed.end(), [&](auto const& function) {
+      return function.first == &instance && !function.second.expired();
+    });
+    if (it != observed.end())
+    {
+      return;
+    }
+    auto token = std::make_shared<char const>();
+    observed.erase(
+        std::remove_if(
+            observed.begin(),
+            observed.end(),
+            [](auto const& function) {
+              return function.second.expired();
+            }),
+        observed.end());
+    observed.emplace_back(&instance, token);
+    instance.transient_observers.emplace_back(
+        [weak = std::weak_ptr<expected_sequence_state>(state),
+         function = static_cast<void const*>(&instance),
+         token = std::move(token)](std::size_t order, auto const&... args) {
+          auto const state = weak.lock();
+          if (!state || state->next == state->steps.size())
+          {
+            return false;
+          }
+          auto const& step = state->steps[state->next];
+          if (step.function == function && order > state->order &&
+              (*static_cast<matcher const*>(step.matcher.get()))(args...))
+          {
+            ++state->next;
+            state->order = order;
+          }
+          return state->next != state->steps.size();
+        });
+  }
+
+  template <typename Instance, typename... Args>
+  expectation expect(Instance& instance, Args&&... args)
+  {
+    auto state = std::make_shared<expectation_state>();
+    instance.observers.emplace_back(
+        [state, expected = std::make_tuple(std::forward<Args>(args)...)](
+            std::size_t, auto const&... args) {
+          if (expected == std::tie(args...))
+          {
+            if (state->count == state->max)
+            {
+              throw expectation_error("member function invoked more times than expected");
+            }
+            ++state->count;
+          }
+        });
+    return expectation(std::move(state));
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_EXPECTATIONS_HPP
@@ -0,0 +1,335 @@
+#ifndef MOCKUP_FIXTURE_HPP
+#define MOCKUP_FIXTURE_HPP
+
+#include <mockup/detail/mapped_file.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/serializer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace mockup::detail
+{
+  // A fixture table starts with a magic number, a version and the value 0x01020304, then
+  // the sizes of a key and a value, the number of records and the tags of the key and
+  // value types. The records follow, each a key and a value, in ascending order of the
+  // bytes of their keys.
+  constexpr char fixture_magic[4] = {'M', 'K', 'F', 'T'};
+  constexpr std::uint32_t fixture_version = 2;
+  constexpr std::uint32_t fixture_byte_order = 0x01020304;
+  constexpr std::size_t fixture_header_size = sizeof(fixture_magic) + 4 * 3 + 4 + 8 * 3;
+
+  // A hash of the names of `Ts`, so that a table is not served for other types of the
+  // same sizes. The names are those the compiler gives, like the byte order and the
+  // layout of the types, so tables are read where they were written.
+  template <typename... Ts>
+  std::uint64_t fixture_type_tag()
+  {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    auto const add = [&hash](char const* name) {
+      // Each name is followed by its terminating null, which separates it from the next.
+      do
+      {
+        hash = (hash ^ static_cast<unsigned char>(*name)) * 0x100000001b3ull;
+      } while (*name++ != '\0');
+    };
+    (..., add(typeid(Ts).name()));
+    return hash;
+  }
+
+  // Arguments are keyed by their bytes, so equal values must have equal bytes. `float`
+  // and `double` are allowed since their keys are normalized; `long double` is not, since
+  // it has padding.
+  template <typename T>
+  constexpr bool is_fixture_key_v = std::has_unique_object_representations_v<T> ||
+      std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+  // Writes the bytes of `value` to `out`. Zeros of either sign, and NaNs, are written as
+  // one value.
+  template <typename T>
+  void write_fixture_key(std::byte* out, T value)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      if (value == 0)
+      {
+        value = T(0);
+      }
+      else if (value != value)
+      {
+        value = std::numeric_limits<T>::quiet_NaN();
+      }
+    }
+    std::memcpy(out, &value, sizeof(value));
+  }
+
+  template <typename... Args>
+  using fixture_key = std::array<std::byte, (std::size_t(0) + ... + sizeof(Args))>;
+
+  template <typename... Args>
+  fixture_key<Args...> make_fixture_key([[maybe_unused]] Args const&... args)
+  {
+    fixture_key<Args...> key{};
+    [[maybe_unused]] std::size_t offset = 0;
+    (..., (write_fixture_key(key.data() + offset, args), offset += sizeof(Args)));
+    return key;
+  }
+
+  // A fixture table mapped into memory. Keys are found by binary search, so only the
+  // pages on the path of a search are read from disk.
+  class fixture_state
+  {
+  private:
+    mapped_view m_file;
+    std::size_t m_key_size = 0;
+    std::size_t m_value_size = 0;
+    std::size_t m_count = 0;
+    std::uint64_t m_key_tag = 0;
+    std::uint64_t m_value_tag = 0;
+
+    template <typename T>
+    T header_field(std::size_t offset) const
+    {
+      T value;
+      std::memcpy(&value, m_file.data() + offset, sizeof(value));
+      return value;
+    }
+
+  public:
+    explicit fixture_state(std::string path)
+    : m_file(std::move(path))
+    {
+      if (m_file.size() < fixture_header_size ||
+          std::memcmp(m_file.data(), fixture_magic, sizeof(fixture_magic)) != 0 ||
+          header_field<std::uint32_t>(4) != fixture_version ||
+          header_field<std::uint32_t>(8) != fixture_byte_order)
+      {
+        throw std::runtime_error(
+            "mockup: not a fixture table written by this version on this machine: " +
+            m_file.path());
+      }
+      m_key_size = header_field<std::uint32_t>(12);
+      m_value_size = header_field<std::uint32_t>(16);
+      auto const count = header_field<std::uint64_t>(20);
+      m_key_tag = header_field<std::uint64_t>(28);
+      m_value_tag = header_field<std::uint64_t>(36);
+      // The count is checked by division, since it could overflow the size of the
+      // records.
+      auto const record_size = m_key_size + m_value_size;
+      auto const records_size = m_file.size() - fixture_header_size;
+      if (record_size == 0 || records_size % record_size != 0 ||
+          records_size / record_size != count)
+      {
+        throw std::runtime_error("mockup: fixture table is truncated: " + m_file.path());
+      }
+      m_count = static_cast<std::size_t>(count);
+    }
+
+    std::size_t key_size() const
+    {
+      return m_key_size;
+    }
+
+    std::size_t value_size() const
+    {
+      return m_value_size;
+    }
+
+    std::size_t size() const
+    {
+      return m_count;
+    }
+
+    std::uint64_t key_tag() const
+    {
+      return m_key_tag;
+    }
+
+    std::uint64_t value_tag() const
+    {
+      return m_value_tag;
+    }
+
+    // The value stored for `key`, or null.
+    std::byte const* find(std::byte const* key) const
+    {
+      auto const record_size = m_key_size + m_value_size;
+      auto const* records = m_file.data() + fixture_header_size;
+      std::size_t first = 0;
+      std::size_t last = m_count;
+      while (first != last)
+      {
+        auto const middle = first + (last - first) / 2;
+        auto const* record = records + middle * record_size;
+        auto const order = m_key_size == 0 ? 0 : std::memcmp(record, key, m_key_size);
+        if (order == 0)
+        {
+          return record + m_key_size;
+        }
+        if (order < 0)
+        {
+          first = middle + 1;
+        }
+        else
+        {
+          last = middle;
+        }
+      }
+      return nullptr;
+    }
+  };
+
+  // The value of a fixture, converted to the return type of the mocked function when it
+  // is returned.
+  struct fixture_value
+  {
+    std::byte const* data;
+    std::size_t size;
+    std::uint64_t tag;
+
+    template <typename T, typename = std::enable_if_t<std::is_trivially_copyable_v<T>>>
+    operator T() const
+    {
+      if (size != sizeof(T) || tag != fixture_type_tag<T>())
+      {
+        throw std::runtime_error("mockup: fixture table was written for another result type");
+      }
+      T value;
+      std::memcpy(&value, data, sizeof(value));
+      return value;
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // The results of a function for many arguments, to be written to a file and served by
+  // `from_table`. Arguments and results must be trivially copyable and are written as
+  // their bytes. Adding a result for arguments that already have one replaces it.
+  template <typename R, typename... Args>
+  class fixture_table<R(Args...)>
+  {
+  private:
+    static_assert(
+        (... && detail::is_fixture_key_v<std::decay_t<Args>>),
+        "fixture arguments must be trivially copyable and have no padding");
+    static_assert(
+        !std::is_void_v<R> && !std::is_reference_v<R> && std::is_trivially_copyable_v<R>,
+        "fixture results must be trivially copyable values");
+
+    static constexpr std::size_t key_size = detail::fixture_key<std::decay_t<Args>...>().size();
+    static constexpr std::size_t record_size = key_size + sizeof(R);
+
+    std::vector<std::byte> m_records;
+
+    std::byte const* record(std::size_t i) const
+    {
+      return m_records.data() + i * record_size;
+    }
+
+  public:
+    void add(std::decay_t<Args> const&... args, R const& result)
+    {
+      auto const key = detail::make_fixture_key(args...);
+      auto const offset = m_records.size();
+      m_records.resize(offset + record_size);
+      std::copy(key.begin(), key.end(), m_records.begin() + offset);
+      std::memcpy(m_records.data() + offset + key_size, &result, sizeof(result));
+    }
+
+    // The number of results added.
+    std::size_t size() const
+    {
+      return m_records.size() / record_size;
+    }
+
+    bool empty() const
+    {
+      return m_records.empty();
+    }
+
+    // Writes the results, sorted by their arguments.
+    void save(std::ostream& out) const
+    {
+      std::vector<std::size_t> order(size());
+      std::iota(order.begin(), order.end(), std::size_t(0));
+      auto const less = [this](std::size_t lhs, std::size_t rhs) {
+        return key_size != 0 && std::memcmp(record(lhs), record(rhs), key_size) < 0;
+      };
+      std::stable_sort(order.begin(), order.end(), less);
+
+      // Of the results added for the same arguments, the last is kept.
+      std::vector<std::size_t> kept;
+      for (std::size_t i = 0; i < order.size(); ++i)
+      {
+        if (i + 1 == order.size() || less(order[i], order[i + 1]))
+        {
+          kept.push_back(order[i]);
+        }
+      }
+
+      out.write(detail::fixture_magic, sizeof(detail::fixture_magic));
+      detail::write_raw(out, detail::fixture_version);
+      detail::write_raw(out, detail::fixture_byte_order);
+      detail::write_raw(out, static_cast<std::uint32_t>(key_size));
+      detail::write_raw(out, static_cast<std::uint32_t>(sizeof(R)));
+      detail::write_raw(out, static_cast<std::uint64_t>(kept.size()));
+      detail::write_raw(out, detail::fixture_type_tag<std::decay_t<Args>...>());
+      detail::write_raw(out, detail::fixture_type_tag<R>());
+      for (auto const i : kept)
+      {
+        out.write(reinterpret_cast<char const*>(record(i)), record_size);
+      }
+      if (!out)
+      {
+        throw std::runtime_error("mockup: cannot write fixture table");
+      }
+    }
+  };
+
+  namespace helpers
+  {
+    // Serves the results stored in the fixture table at `path` for the arguments of each
+    // call. The file is mapped into memory, so tables larger than memory can be served.
+    // Throws `std::out_of_range` for arguments that have no result, and
+    // `std::runtime_error` if the table was written for other argument or result types.
+    inline auto from_table(std::string path)
+    {
+      return [table = std::make_shared<detail::fixture_state>(std::move(path))](
+                 auto const&... args) -> detail::fixture_value {
+        static_assert(
+            (... && detail::is_fixture_key_v<std::decay_t<decltype(args)>>),
+            "fixture arguments must be trivially copyable and have no padding");
+        auto const key = detail::make_fixture_key(args...);
+        if (key.size() != table->key_size() ||
+            table->key_tag() != detail::fixture_type_tag<std::decay_t<decltype(args)>...>())
+        {
+          throw std::runtime_error("mockup: fixture table was written for other argument types");
+        }
+        auto const* value = table->find(key.data());
+        if (value == nullptr)
+        {
+          throw std::out_of_range("mockup: no fixture with these arguments");
+        }
+        return {value, table->value_size(), table->value_tag()};
+      };
+    }
+  } // namespace helpers
+
+  using namespace helpers;
+} // namespace mockup
+
+#endif // MOCKUP_FIXTURE_HPP
@@ -0,0 +1,69 @@
+#ifndef MOCKUP_FUNCTIONS_HPP
+#define MOCKUP_FUNCTIONS_HPP
+
+#include <mockup/detail/member_function.hpp>
+#include <mockup/fwd.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace mockup::detail
+{
+  template <auto>
+  struct constant
+  {
+  };
+
+  template <auto MemberFunction, auto... MemberFunctions>
+  constexpr std::size_t index_of()
+  {
+    constexpr bool same[] = {
+        std::is_same_v<constant<MemberFunction>, constant<MemberFunctions>>...};
+    std::size_t index = 0;
+    while (!same[index])
+    {
+      ++index;
+    }
+    return index;
+  }
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // Stores the state of the listed member functions inside the mocked object itself.
+  // Declared as a data member named `mockup_functions`, it replaces the per-call map
+  // lookup with a direct member access, so mocks that are injected as template
+  // parameters need neither a virtual interface nor a registry.
+  template <auto... MemberFunctions>
+  class functions
+  {
+  private:
+    mutable std::tuple<
+        detail::member_function_instance<detail::member_function_signature_t<MemberFunctions>>...>
+        m_instances;
+    mutable detail::mock_settings m_settings;
+
+  public:
+    template <auto MemberFunction>
+    static constexpr bool contains =
+        (... || std::is_same_v<detail::constant<MemberFunction>, detail::constant<MemberFunctions>>);
+
+    template <auto MemberFunction>
+    auto& get() const
+    {
+      static_assert(contains<MemberFunction>, "member function is not listed");
+      auto& instance =
+          std::get<detail::index_of<MemberFunction, MemberFunctions...>()>(m_instances);
+      instance.settings = &m_settings;
+      return instance;
+    }
+
+    detail::mock_settings& settings() const
+    {
+      return m_settings;
+    }
+  };
+} // namespace mockup
+
+#endif // MOCKUP_FUNCTIONS_HPP
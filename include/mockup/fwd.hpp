@@ -0,0 +1,127 @@
+#ifndef MOCKUP_FWD_HPP
+#define MOCKUP_FWD_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace mockup
+{
+  struct sequence;
+
+  struct checkpoint_t;
+
+  class expected_sequence;
+
+  class expectation;
+
+  class expectation_error;
+
+  enum class log_layout;
+
+  template <typename Mock>
+  class mock;
+
+  template <typename Signature>
+  class fixture_table;
+
+  template <auto... MemberFunctions>
+  class functions;
+
+  class golden_trace;
+
+  template <typename>
+  class mock_function;
+
+  namespace detail
+  {
+    struct match_all;
+  } // namespace detail
+
+  template <typename Log, typename Filter = detail::match_all>
+  class invocation_view;
+
+  template <typename Signature>
+  struct c_callback;
+
+  template <typename T>
+  class tracked;
+
+  template <typename T>
+  class tracked_histogram;
+
+  template <typename Signature>
+  class recording;
+
+  template <typename T, typename Enable = void>
+  struct serializer;
+
+  class trace;
+
+  template <typename Signature>
+  class trace_log;
+
+  class trace_writer;
+
+  class verifier;
+
+  class verification_report;
+
+  struct verification_result;
+
+  template <typename P>
+  class predicate_t;
+
+  template <typename>
+  struct overload_t;
+
+  namespace helpers
+  {
+    struct wildcard_t;
+
+    template <typename T>
+    class reference;
+  } // namespace helpers
+
+  namespace capture
+  {
+    struct copy_t;
+
+    struct view_t;
+
+    struct none_t;
+
+    struct intern_t;
+
+    template <typename Projection>
+    struct projection_t;
+  } // namespace capture
+} // namespace mockup
+
+namespace mockup::detail
+{
+  template <typename>
+  struct member_function_instance;
+
+  class intern_tables;
+
+  template <std::size_t I, typename... Args>
+  using decayed_argument_t = std::decay_t<std::tuple_element_t<I, std::tuple<Args...>>>;
+
+  // The features that mocks expose through these functions are defined in their own
+  // headers, which need only be included where the features are used.
+  template <std::size_t I, typename R, typename... Args>
+  tracked<decayed_argument_t<I, Args...>> track(member_function_instance<R(Args...)>& instance);
+
+  template <std::size_t I, typename R, typename... Args>
+  tracked_histogram<decayed_argument_t<I, Args...>> track_histogram(
+      member_function_instance<R(Args...)>& instance);
+
+  template <typename Instance, typename... Args>
+  void expect(Instance& instance, expected_sequence& seq, Args&&... args);
+
+  template <typename Instance, typename... Args>
+  expectation expect(Instance& instance, Args&&... args);
+} // namespace mockup::detail
+
+#endif // MOCKUP_FWD_HPP
@@ -0,0 +1,238 @@
+#ifndef MOCKUP_GOLDEN_HPP
+#define MOCKUP_GOLDEN_HPP
+
+#include <mockup/detail/member_function.hpp>
+#include <mockup/error.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/mock.hpp>
+#include <mockup/mock_function.hpp>
+#include <mockup/trace.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace mockup::detail
+{
+  // A call as its function name and the first bytes of its serialized arguments.
+  inline std::string describe_call(std::string const& function, std::string const& arguments)
+  {
+    constexpr std::size_t max_bytes = 24;
+    constexpr char digits[] = "0123456789abcdef";
+    std::string result = function + "(";
+    for (std::size_t i = 0; i < std::min(arguments.size(), max_bytes); ++i)
+    {
+      auto const byte = static_cast<unsigned char>(arguments[i]);
+      if (i != 0)
+      {
+        result += ' ';
+      }
+      result += digits[byte >> 4];
+      result += digits[byte & 0xf];
+    }
+    if (arguments.size() > max_bytes)
+    {
+      result += " ...";
+    }
+    return result + ")";
+  }
+
+  // The position in a golden trace, the last calls that matched it and, once the calls
+  // diverge from it, a report of where.
+  struct golden_state
+  {
+    trace_reader reader;
+    std::size_t context;
+    std::size_t matched = 0;
+    std::deque<std::string> window;
+    std::optional<std::string> report;
+    std::ostringstream buffer;
+
+    golden_state(std::istream& in, std::size_t context)
+    : reader(in)
+    , context(context)
+    {
+    }
+
+    // Compares a call with the next call of the golden trace. Orders are not compared,
+    // since they depend on the calls made before a trace was started.
+    bool check(std::string const& function, std::string const& arguments)
+    {
+      if (report)
+      {
+        return false;
+      }
+      trace_reader::call expected;
+      if (!reader.next(expected))
+      {
+        diverge(std::nullopt, describe_call(function, arguments));
+      }
+      else if (*expected.function != function || expected.arguments != arguments)
+      {
+        diverge(
+            describe_call(*expected.function, expected.arguments),
+            describe_call(function, arguments));
+      }
+      else
+      {
+        ++matched;
+        if (context != 0)
+        {
+          if (window.size() == context)
+          {
+            window.pop_front();
+          }
+          window.push_back(describe_call(function, arguments));
+        }
+      }
+      return !report;
+    }
+
+    bool finish()
+    {
+      if (report)
+      {
+        return false;
+      }
+      trace_reader::call expected;
+      if (reader.next(expected))
+      {
+        diverge(describe_call(*expected.function, expected.arguments), std::nullopt);
+      }
+      return !report;
+    }
+
+  private:
+    void diverge(
+        std::optional<std::string> const& expected, std::optional<std::string> const& actual)
+    {
+      std::string text = "mockup: call " + std::to_string(matched + 1) +
+          " diverges from the golden trace\n  expected: " + expected.value_or("no more calls") +
+          "\n  actual:   " + actual.value_or("no more calls") + "\n";
+      if (!window.empty())
+      {
+        text += "  after:\n";
+        for (auto const& call : window)
+        {
+          text += "    " + call + "\n";
+        }
+      }
+      if (expected && context != 0)
+      {
+        // The golden calls that were to follow are read only now, to show what the
+        // calls were expected to do next.
+        trace_reader::call next;
+        for (std::size_t i = 0; i < context && reader.next(next); ++i)
+        {
+          text += (i == 0 ? "  golden trace continues with:\n    " : "    ") +
+              describe_call(*next.function, next.arguments) + "\n";
+        }
+      }
+      window.clear();
+      report = std::move(text);
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // Compares the calls to mocked functions with a golden trace written by `trace_writer`
+  // as the calls are made. Golden calls are read one at a time and only the last
+  // `context` matching calls are kept, so traces of any length are compared in constant
+  // memory. The first call that differs throws `expectation_error` with a report of the
+  // calls around it; later calls are not compared.
+  class golden_trace
+  {
+  private:
+    std::shared_ptr<detail::golden_state> m_state;
+
+    template <typename R, typename... Args>
+    void follow(std::string name, detail::member_function_instance<R(Args...)>& instance)
+    {
+      instance.observers.emplace_back(
+          [state = m_state, name = std::move(name)](std::size_t, auto const&... args) {
+            if (state->report)
+            {
+              return;
+            }
+            state->buffer.str({});
+            detail::write_arguments(state->buffer, args...);
+            if (!state->check(name, state->buffer.str()))
+            {
+              throw expectation_error(*state->report);
+            }
+          });
+    }
+
+  public:
+    // Reads the golden trace from `golden`, which must outlive the comparison.
+    explicit golden_trace(std::istream& golden, std::size_t context = 8)
+    : m_state(std::make_shared<detail::golden_state>(golden, context))
+    {
+    }
+
+    // Compares each call to `MemberFunction` of `mock` with the golden trace, as a call
+    // to the function `name`. Works with recording disabled.
+    template <auto MemberFunction, typename Mock>
+    void follow(std::string name, mock<Mock>& mock)
+    {
+      follow(
+          std::move(name),
+          detail::get_member_function_instance<MemberFunction>(mock.operator->()));
+    }
+
+    template <typename Signature>
+    void follow(std::string name, mock_function<Signature>& function)
+    {
+      follow(std::move(name), detail::mock_function_access::instance(function));
+    }
+
+    // Compares the calls of another trace with the golden trace, one at a time. Returns
+    // whether they are the same calls.
+    bool compare(std::istream& actual)
+    {
+      detail::trace_reader reader(actual);
+      detail::trace_reader::call call;
+      while (reader.next(call))
+      {
+        if (!m_state->check(*call.function, call.arguments))
+        {
+          return false;
+        }
+      }
+      return finish();
+    }
+
+    // Whether every golden call was made, with no divergence. Golden calls that were
+    // never made are reported as a divergence.
+    bool finish()
+    {
+      return m_state->finish();
+    }
+
+    bool diverged() const
+    {
+      return m_state->report.has_value();
+    }
+
+    // The number of calls that matched the golden trace.
+    std::size_t matched() const
+    {
+      return m_state->matched;
+    }
+
+    // A description of the first divergence, or an empty string.
+    std::string report() const
+    {
+      return m_state->report.value_or(std::string());
+    }
+  };
+} // namespace mockup
+
+#endif // MOCKUP_GOLDEN_HPP
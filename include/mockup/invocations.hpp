@@ -0,0 +1,360 @@
+#ifndef MOCKUP_INVOCATIONS_HPP
+#define MOCKUP_INVOCATIONS_HPP
+
+#include <mockup/detail/hash.hpp>
+#include <mockup/detail/invocation_log.hpp>
+#include <mockup/detail/sum.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/layout.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+namespace mockup::detail
+{
+  struct match_all
+  {
+    template <typename... Args>
+    constexpr bool operator()(Args const&...) const
+    {
+      return true;
+    }
+  };
+
+  // Compare and hash arguments through pointers into the log, so that counting distinct
+  // values copies none of them.
+  struct indirect_hash
+  {
+    template <typename T>
+    std::size_t operator()(T const* value) const
+    {
+      return std::hash<T>()(*value);
+    }
+  };
+
+  struct indirect_equal
+  {
+    template <typename T>
+    bool operator()(T const* lhs, T const* rhs) const
+    {
+      return *lhs == *rhs;
+    }
+  };
+
+  struct indirect_less
+  {
+    template <typename T>
+    bool operator()(T const* lhs, T const* rhs) const
+    {
+      return *lhs < *rhs;
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // A lazy view of the recorded invocations of one member function. Elements refer to
+  // the arguments stored in the log, so nothing is copied; the view is invalidated by
+  // further calls to the function.
+  template <typename Log, typename Filter>
+  class invocation_view
+  {
+  private:
+    Log const* m_log;
+    std::size_t m_begin;
+    std::size_t m_end;
+    Filter m_filter;
+
+    bool matches(std::size_t index) const
+    {
+      if constexpr (std::is_same_v<Filter, detail::match_all>)
+      {
+        return true;
+      }
+      else
+      {
+        return m_log->match(index, m_filter);
+      }
+    }
+
+    template <std::size_t I>
+    using argument_t = std::decay_t<decltype(std::declval<Log const&>().template get<I>(0))>;
+
+    // Calls `f` with argument `I` of each invocation in the view. An unfiltered view of a
+    // log in the column layout reads the column directly.
+    template <std::size_t I, typename F>
+    void for_each_argument(F&& f) const
+    {
+      if constexpr (std::is_same_v<Filter, detail::match_all>)
+      {
+        if (m_log->has_columns())
+        {
+          auto const& column = m_log->template column<I>();
+          for (auto i = m_begin; i != m_end; ++i)
+          {
+            f(detail::unwrap<argument_t<I>>(column[i]));
+          }
+          return;
+        }
+      }
+      for (auto i = m_begin; i != m_end; ++i)
+      {
+        if (matches(i))
+        {
+          f(m_log->template get<I>(i));
+        }
+      }
+    }
+
+  public:
+    using value_type = decltype(std::declval<Log const&>()[0]);
+
+    class iterator
+    {
+    private:
+      invocation_view const* m_view;
+      std::size_t m_index;
+
+      void skip()
+      {
+        while (m_index != m_view->m_end && !m_view->matches(m_index))
+        {
+          ++m_index;
+        }
+      }
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = invocation_view::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = value_type;
+
+      iterator(invocation_view const& view, std::size_t index)
+      : m_view(&view)
+      , m_index(index)
+      {
+        skip();
+      }
+
+      value_type operator*() const
+      {
+        return (*m_view->m_log)[m_index];
+      }
+
+      iterator& operator++()
+      {
+        ++m_index;
+        skip();
+        return *this;
+      }
+
+      iterator operator++(int)
+      {
+        auto result = *this;
+        ++*this;
+        return result;
+      }
+
+      bool operator==(iterator const& other) const
+      {
+        return m_index == other.m_index;
+      }
+
+      bool operator!=(iterator const& other) const
+      {
+        return m_index != other.m_index;
+      }
+    };
+
+    invocation_view(Log const& log, std::size_t begin, std::size_t end, Filter filter = {})
+    : m_log(&log)
+    , m_begin(begin)
+    , m_end(end)
+    , m_filter(std::move(filter))
+    {
+    }
+
+    explicit invocation_view(Log const& log)
+    : invocation_view(log, 0, log.size())
+    {
+    }
+
+    iterator begin() const
+    {
+      return {*this, m_begin};
+    }
+
+    iterator end() const
+    {
+      return {*this, m_end};
+    }
+
+    // Narrows the view to the invocations whose arguments match.
+    template <typename... Matchers>
+    auto where(Matchers&&... matchers) const
+    {
+      auto filter = [previous = m_filter,
+                     expected = std::make_tuple(std::forward<Matchers>(matchers)...)](
+                        auto const&... args) {
+        return previous(args...) && expected == std::tie(args...);
+      };
+      return invocation_view<Log, decltype(filter)>(
+          *m_log, m_begin, m_end, std::move(filter));
+    }
+
+    std::size_t count() const
+    {
+      if constexpr (std::is_same_v<Filter, detail::match_all>)
+      {
+        return m_end - m_begin;
+      }
+      else
+      {
+        std::size_t result = 0;
+        for (auto i = m_begin; i != m_end; ++i)
+        {
+          result += matches(i) ? 1 : 0;
+        }
+        return result;
+      }
+    }
+
+    bool empty() const
+    {
+      return begin() == end();
+    }
+
+    // The invocation at position `n` of the view, counting from zero.
+    value_type nth(std::size_t n) const
+    {
+      if constexpr (std::is_same_v<Filter, detail::match_all>)
+      {
+        if (n < m_end - m_begin)
+        {
+          return (*m_log)[m_begin + n];
+        }
+      }
+      else
+      {
+        for (auto i = m_begin; i != m_end; ++i)
+        {
+          if (matches(i) && n-- == 0)
+          {
+            return (*m_log)[i];
+          }
+        }
+      }
+      throw std::out_of_range("invocation_view::nth");
+    }
+
+    value_type first() const
+    {
+      return nth(0);
+    }
+
+    value_type last() const
+    {
+      for (auto i = m_end; i != m_begin; --i)
+      {
+        if (matches(i - 1))
+        {
+          return (*m_log)[i - 1];
+        }
+      }
+      throw std::out_of_range("invocation_view::last");
+    }
+
+    // The sum of argument `I` over the view, starting from a value-initialized total.
+    // Integers are summed as `long long` or `unsigned long long`.
+    template <std::size_t I>
+    auto sum() const
+    {
+      using T = argument_t<I>;
+      detail::sum_t<T> result{};
+      for_each_argument<I>([&](T const& value) {
+        result += value;
+      });
+      return result;
+    }
+
+    template <std::size_t I>
+    argument_t<I> const& min() const
+    {
+      argument_t<I> const* result = nullptr;
+      for_each_argument<I>([&](argument_t<I> const& value) {
+        if (!result || value < *result)
+        {
+          result = &value;
+        }
+      });
+      if (!result)
+      {
+        throw std::out_of_range("invocation_view::min");
+      }
+      return *result;
+    }
+
+    template <std::size_t I>
+    argument_t<I> const& max() const
+    {
+      argument_t<I> const* result = nullptr;
+      for_each_argument<I>([&](argument_t<I> const& value) {
+        if (!result || *result < value)
+        {
+          result = &value;
+        }
+      });
+      if (!result)
+      {
+        throw std::out_of_range("invocation_view::max");
+      }
+      return *result;
+    }
+
+    // The number of invocations in the view for each value of argument `I`.
+    template <std::size_t I>
+    std::map<argument_t<I>, std::size_t> histogram() const
+    {
+      std::map<argument_t<I>, std::size_t> result;
+      for_each_argument<I>([&](argument_t<I> const& value) {
+        ++result[value];
+      });
+      return result;
+    }
+
+    // The number of different values of argument `I` in the view. Hashable arguments
+    // are counted with a hash set, others with an ordered set.
+    template <std::size_t I>
+    std::size_t distinct_count() const
+    {
+      using T = argument_t<I>;
+      if constexpr (detail::is_hashable_v<T>)
+      {
+        std::unordered_set<T const*, detail::indirect_hash, detail::indirect_equal> values;
+        for_each_argument<I>([&](T const& value) {
+          values.insert(&value);
+        });
+        return values.size();
+      }
+      else
+      {
+        std::set<T const*, detail::indirect_less> values;
+        for_each_argument<I>([&](T const& value) {
+          values.insert(&value);
+        });
+        return values.size();
+      }
+    }
+  };
+} // namespace mockup
+
+#endif // MOCKUP_INVOCATIONS_HPP
@@ -0,0 +1,17 @@
+#ifndef MOCKUP_LAYOUT_HPP
+#define MOCKUP_LAYOUT_HPP
+
+#include <mockup/fwd.hpp>
+
+namespace mockup
+{
+  // How the invocation log of a member function stores recorded arguments: one row per
+  // invocation, or one column per argument position.
+  enum class log_layout
+  {
+    rows,
+    columns
+  };
+} // namespace mockup
+
+#endif // MOCKUP_LAYOUT_HPP
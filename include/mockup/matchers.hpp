@@ -0,0 +1,116 @@
+#ifndef MOCKUP_MATCHERS_HPP
+#define MOCKUP_MATCHERS_HPP
+
+#include <mockup/detail/compare.hpp>
+#include <mockup/fwd.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace mockup
+{
+  namespace helpers
+  {
+    struct wildcard_t
+    {
+      explicit constexpr wildcard_t(int)
+      {
+      }
+    };
+
+    template <typename T>
+    bool operator==(wildcard_t, T const&)
+    {
+      return true;
+    }
+
+    template <typename T>
+    bool operator==(T const&, wildcard_t)
+    {
+      return true;
+    }
+
+    template <typename T>
+    bool operator!=(wildcard_t, T const&)
+    {
+      return false;
+    }
+
+    template <typename T>
+    bool operator!=(T const&, wildcard_t)
+    {
+      return false;
+    }
+
+    constexpr wildcard_t wildcard{0};
+    constexpr wildcard_t _{0};
+  } // namespace helpers
+
+  using namespace helpers;
+
+  template <typename P>
+  class predicate_t
+  {
+  private:
+    friend struct detail::predicate_access;
+
+    P m_predicate;
+
+  public:
+    template <typename F>
+    explicit predicate_t(F&& f)
+    : m_predicate(std::forward<F>(f))
+    {
+    }
+
+    template <typename T>
+    bool operator==(T const& t) const
+    {
+      return m_predicate(t);
+    }
+  };
+
+  template <typename P>
+  auto predicate(P&& p)
+  {
+    return predicate_t<std::decay_t<P>>(std::forward<P>(p));
+  }
+
+  template <typename T>
+  auto equal_to(T&& t)
+  {
+    return predicate(detail::compare<detail::equal, std::decay_t<T>>{std::forward<T>(t)});
+  }
+
+  template <typename T>
+  auto not_equal_to(T&& t)
+  {
+    return predicate(detail::compare<detail::not_equal, std::decay_t<T>>{std::forward<T>(t)});
+  }
+
+  template <typename T>
+  auto less_than(T&& t)
+  {
+    return predicate(detail::compare<detail::less, std::decay_t<T>>{std::forward<T>(t)});
+  }
+
+  template <typename T>
+  auto less_than_or_equal_to(T&& t)
+  {
+    return predicate(detail::compare<detail::less_equal, std::decay_t<T>>{std::forward<T>(t)});
+  }
+
+  template <typename T>
+  auto greater_than(T&& t)
+  {
+    return predicate(detail::compare<detail::greater, std::decay_t<T>>{std::forward<T>(t)});
+  }
+
+  template <typename T>
+  auto greater_than_or_equal_to(T&& t)
+  {
+    return predicate(detail::compare<detail::greater_equal, std::decay_t<T>>{std::forward<T>(t)});
+  }
+} // namespace mockup
+
+#endif // MOCKUP_MATCHERS_HPP
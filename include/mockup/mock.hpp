@@ -0,0 +1,262 @@
+#ifndef MOCKUP_MOCK_HPP
+#define MOCKUP_MOCK_HPP
+
+#include <mockup/detail/class_instance.hpp>
+#include <mockup/detail/member_function.hpp>
+#include <mockup/detail/operations.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/sequence.hpp>
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace mockup
+{
+  template <typename Mock>
+  class mock
+  {
+  private:
+    Mock m_mock;
+
+  public:
+    template <typename... Args>
+    explicit mock(Args&&... args)
+    : m_mock(std::forward<Args>(args)...)
+    {
+    }
+
+    mock(mock const&) = delete;
+    mock(mock&&) = delete;
+
+    ~mock()
+    {
+      detail::destroy_class_instance(&m_mock);
+    }
+
+    mock& operator=(mock const&) = delete;
+    mock& operator=(mock&&) = delete;
+
+    Mock const& operator*() const
+    {
+      return m_mock;
+    }
+
+    Mock& operator*()
+    {
+      return m_mock;
+    }
+
+    Mock const* operator->() const
+    {
+      return &m_mock;
+    }
+
+    Mock* operator->()
+    {
+      return &m_mock;
+    }
+
+    template <auto MemberFunction, typename... Args>
+    auto when(Args&&... args)
+    {
+      return detail::when(
+          detail::get_member_function_instance<MemberFunction>(&m_mock),
+          std::forward<Args>(args)...);
+    }
+
+    template <auto MemberFunction, typename... Args>
+    bool invoked(Args const&... args)
+    {
+      return detail::invoked(
+          detail::get_member_function_instance<MemberFunction>(&m_mock), args...);
+    }
+
+    template <auto MemberFunction, typename... Args>
+    bool invoked(sequence& seq, Args const&... args)
+    {
+      return detail::invoked(
+          detail::get_member_function_instance<MemberFunction>(&m_mock), seq, args...);
+    }
+
+    template <auto MemberFunction>
+    auto invocations()
+    {
+      auto& instance = detail::get_member_function_instance<MemberFunction>(&m_mock);
+      return invocation_view<std::decay_t<decltype(instance.invocations)>>(
+          instance.invocations);
+    }
+
+    // Tracks argument `I` of the member function from now on.
+    template <auto MemberFunction, std::size_t I>
+    auto track()
+    {
+      return detail::track<I>(detail::get_member_function_instance<MemberFunction>(&m_mock));
+    }
+
+    template <auto MemberFunction, std::size_t I>
+    auto track_histogram()
+    {
+      return detail::track_histogram<I>(
+          detail::get_member_function_instance<MemberFunction>(&m_mock));
+    }
+
+    template <auto MemberFunction, typename... Args>
+    bool invoked_since(checkpoint_t cp, Args const&... args)
+    {
+      return detail::invoked_between(
+          detail::get_member_function_instance<MemberFunction>(&m_mock),
+          cp.order,
+          detail::end_of_order,
+          args...);
+    }
+
+    template <auto MemberFunction, typename... Args>
+    bool invoked_between(checkpoint_t first, checkpoint_t last, Args const&... args)
+    {
+      return detail::invoked_between(
+          detail::get_member_function_instance<MemberFunction>(&m_mock),
+          first.order,
+          last.order,
+          args...);
+    }
+
+    template <auto MemberFunction, typename... Args>
+    std::size_t times(Args const&... args)
+    {
+      return detail::times_between(
+          detail::get_member_function_instance<MemberFunction>(&m_mock),
+          0,
+          detail::end_of_order,
+          args...);
+    }
+
+    template <auto MemberFunction, typename... Args>
+    std::size_t times_since(checkpoint_t cp, Args const&... args)
+    {
+      return detail::times_between(
+          detail::get_member_function_instance<MemberFunction>(&m_mock),
+          cp.order,
+          detail::end_of_order,
+          args...);
+    }
+
+    template <auto MemberFunction, typename... Args>
+    std::size_t times_between(checkpoint_t first, checkpoint_t last, Args const&... args)
+    {
+      return detail::times_between(
+          detail::get_member_function_instance<MemberFunction>(&m_mock),
+          first.order,
+          last.order,
+          args...);
+    }
+
+    checkpoint_t checkpoint() const
+    {
+      return mockup::checkpoint();
+    }
+
+    template <auto MemberFunction, typename... Args>
+    void expect(expected_sequence& seq, Args&&... args)
+    {
+      detail::expect(
+          detail::get_member_function_instance<MemberFunction>(&m_mock),
+          seq,
+          std::forward<Args>(args)...);
+    }
+
+    template <auto MemberFunction, typename... Args>
+    auto expect(Args&&... args)
+    {
+      return detail::expect(
+          detail::get_member_function_instance<MemberFunction>(&m_mock),
+          std::forward<Args>(args)...);
+    }
+
+    void strict(bool enabled = true)
+    {
+      detail::get_mock_settings(&m_mock).strict = enabled;
+    }
+
+    template <auto MemberFunction>
+    void strict(bool enabled = true)
+    {
+      detail::get_member_function_instance<MemberFunction>(&m_mock).strict = enabled;
+    }
+
+    // Keeps a Bloom filter of `bits` bits over the recorded arguments of each member
+    // function, so that checks for exact values that were never passed return without
+    // scanning the log. Zero disables the filters.
+    void bloom_filter(std::size_t bits)
+    {
+      detail::get_mock_settings(&m_mock).filter_bits = bits;
+    }
+
+    template <auto MemberFunction>
+    void bloom_filter(std::size_t bits)
+    {
+      detail::get_member_function_instance<MemberFunction>(&m_mock).filter_bits = bits;
+    }
+
+    template <auto MemberFunction>
+    void record(bool enabled)
+    {
+      detail::get_member_function_instance<MemberFunction>(&m_mock).recording = enabled;
+    }
+
+    // Forgets the recorded calls of the member function, including any spilled to disk.
+    // Actions, expectations, tracking and settings are kept.
+    template <auto MemberFunction>
+    void clear()
+    {
+      detail::get_member_function_instance<MemberFunction>(&m_mock).invocations.clear();
+    }
+
+    // Sets how argument `I` of calls recorded from now on is stored: `capture::copy`,
+    // `capture::view`, `capture::none`, `capture::intern` or `capture::project(f)`.
+    template <auto MemberFunction, std::size_t I, typename Policy>
+    void capture(Policy const& policy)
+    {
+      detail::get_member_function_instance<MemberFunction>(&m_mock)
+          .invocations.template capture<I>(policy, detail::get_mock_settings(&m_mock).interns);
+    }
+
+    // Records consecutive identical calls as one run with a count, when `enabled`.
+    template <auto MemberFunction>
+    void compress(bool enabled)
+    {
+      detail::get_member_function_instance<MemberFunction>(&m_mock).invocations.compress(
+          enabled);
+    }
+
+    // Moves recorded calls to a memory-mapped file at `path` whenever `threshold` of them
+    // are held in memory. The arguments must all be of scalar type. The file is removed
+    // when the mock is destroyed, unless `keep` is true. Needs `<mockup/spill.hpp>`.
+    template <auto MemberFunction>
+    void spill(std::string const& path, std::size_t threshold, bool keep = false)
+    {
+      detail::get_member_function_instance<MemberFunction>(&m_mock).invocations.spill(
+          detail::spill_file<decltype(MemberFunction)>::open(path, keep), threshold);
+    }
+
+    template <auto MemberFunction>
+    void layout(log_layout layout)
+    {
+      detail::get_member_function_instance<MemberFunction>(&m_mock).invocations.layout(layout);
+    }
+  };
+
+  template <auto MemberFunction, typename Mock, typename... Args>
+  decltype(auto) invoke(Mock const& mock, Args&&... args)
+  {
+    static_assert(
+        detail::is_recordable<detail::member_function_signature_t<MemberFunction>, Args...>::
+            value,
+        "arguments that cannot be copied must be taken by value or passed with ref()");
+    return detail::get_member_function_instance<MemberFunction>(&mock)(
+        std::forward<Args>(args)...);
+  }
+} // namespace mockup
+
+#endif // MOCKUP_MOCK_HPP
@@ -0,0 +1,187 @@
+#ifndef MOCKUP_MOCK_FUNCTION_HPP
+#define MOCKUP_MOCK_FUNCTION_HPP
+
+#include <mockup/detail/member_function.hpp>
+#include <mockup/detail/operations.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/sequence.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace mockup::detail
+{
+  struct mock_function_access
+  {
+    template <typename Signature>
+    static auto& instance(mock_function<Signature> const& function)
+    {
+      return function.m_instance;
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // A standalone mocked function that owns its state directly, for injecting
+  // callbacks without mocking a whole class. Pass `std::ref(f)` where a copyable
+  // function object such as `std::function` is required.
+  template <typename R, typename... Args>
+  class mock_function<R(Args...)>
+  {
+  private:
+    mutable detail::member_function_instance<R(Args...)> m_instance;
+    std::shared_ptr<detail::intern_tables> m_interns;
+
+    friend struct detail::mock_function_access;
+
+  public:
+    mock_function() = default;
+
+    mock_function(mock_function const&) = delete;
+    mock_function(mock_function&&) = delete;
+
+    mock_function& operator=(mock_function const&) = delete;
+    mock_function& operator=(mock_function&&) = delete;
+
+    R operator()(Args... args) const
+    {
+      return m_instance(std::forward<Args>(args)...);
+    }
+
+    template <typename... Matchers>
+    auto when(Matchers&&... matchers)
+    {
+      return detail::when(m_instance, std::forward<Matchers>(matchers)...);
+    }
+
+    template <typename... Matchers>
+    bool invoked(Matchers const&... matchers) const
+    {
+      return detail::invoked(m_instance, matchers...);
+    }
+
+    template <typename... Matchers>
+    bool invoked(sequence& seq, Matchers const&... matchers) const
+    {
+      return detail::invoked(m_instance, seq, matchers...);
+    }
+
+    auto invocations() const
+    {
+      return invocation_view<detail::invocation_log<Args...>>(m_instance.invocations);
+    }
+
+    // Tracks argument `I` from now on.
+    template <std::size_t I>
+    auto track() const
+    {
+      return detail::track<I>(m_instance);
+    }
+
+    template <std::size_t I>
+    auto track_histogram() const
+    {
+      return detail::track_histogram<I>(m_instance);
+    }
+
+    template <typename... Matchers>
+    bool invoked_since(checkpoint_t cp, Matchers const&... matchers) const
+    {
+      return detail::invoked_between(
+          m_instance, cp.order, detail::end_of_order, matchers...);
+    }
+
+    template <typename... Matchers>
+    bool invoked_between(
+        checkpoint_t first, checkpoint_t last, Matchers const&... matchers) const
+    {
+      return detail::invoked_between(m_instance, first.order, last.order, matchers...);
+    }
+
+    template <typename... Matchers>
+    std::size_t times(Matchers const&... matchers) const
+    {
+      return detail::times_between(m_instance, 0, detail::end_of_order, matchers...);
+    }
+
+    template <typename... Matchers>
+    std::size_t times_since(checkpoint_t cp, Matchers const&... matchers) const
+    {
+      return detail::times_between(
+          m_instance, cp.order, detail::end_of_order, matchers...);
+    }
+
+    template <typename... Matchers>
+    std::size_t times_between(
+        checkpoint_t first, checkpoint_t last, Matchers const&... matchers) const
+    {
+      return detail::times_between(m_instance, first.order, last.order, matchers...);
+    }
+
+    checkpoint_t checkpoint() const
+    {
+      return mockup::checkpoint();
+    }
+
+    template <typename... Matchers>
+    void expect(expected_sequence& seq, Matchers&&... matchers)
+    {
+      detail::expect(m_instance, seq, std::forward<Matchers>(matchers)...);
+    }
+
+    template <typename... Matchers>
+    auto expect(Matchers&&... matchers)
+    {
+      return detail::expect(m_instance, std::forward<Matchers>(matchers)...);
+    }
+
+    void bloom_filter(std::size_t bits)
+    {
+      m_instance.filter_bits = bits;
+    }
+
+    void record(bool enabled)
+    {
+      m_instance.recording = enabled;
+    }
+
+    // Forgets the recorded calls. Actions, expectations, tracking and settings are kept.
+    void clear()
+    {
+      m_instance.invocations.clear();
+    }
+
+    template <std::size_t I, typename Policy>
+    void capture(Policy const& policy)
+    {
+      m_instance.invocations.template capture<I>(policy, m_interns);
+    }
+
+    void compress(bool enabled)
+    {
+      m_instance.invocations.compress(enabled);
+    }
+
+    // See `mock::spill`. Needs `<mockup/spill.hpp>`.
+    void spill(std::string const& path, std::size_t threshold, bool keep = false)
+    {
+      m_instance.invocations.spill(
+          detail::spill_file<R(Args...)>::open(path, keep), threshold);
+    }
+
+    void layout(log_layout layout)
+    {
+      m_instance.invocations.layout(layout);
+    }
+
+    void strict(bool enabled = true)
+    {
+      m_instance.strict = enabled;
+    }
+  };
+} // namespace mockup
+
+#endif // MOCKUP_MOCK_FUNCTION_HPP
@@ -0,0 +1,55 @@
+#ifndef MOCKUP_OVERLOAD_HPP
+#define MOCKUP_OVERLOAD_HPP
+
+#include <mockup/fwd.hpp>
+
+namespace mockup
+{
+  template <typename>
+  struct overload_t;
+
+  template <typename R, typename... Args>
+  struct overload_t<R(Args...)>
+  {
+    explicit constexpr overload_t(int)
+    {
+    }
+
+    template <typename T>
+    constexpr auto operator()(R (T::*m)(Args...)) const
+    {
+      return m;
+    }
+  };
+
+  template <typename R, typename... Args>
+  struct overload_t<R(Args...) const>
+  {
+    explicit constexpr overload_t(int)
+    {
+    }
+
+    template <typename T>
+    constexpr auto operator()(R (T::*m)(Args...) const) const
+    {
+      return m;
+    }
+  };
+
+  template <typename F>
+  inline constexpr overload_t<F> overload{0};
+
+  template <typename... Args, typename R, typename T>
+  constexpr auto const_(R (T::*m)(Args...) const)
+  {
+    return m;
+  }
+
+  template <typename... Args, typename R, typename T>
+  constexpr auto non_const(R (T::*m)(Args...))
+  {
+    return m;
+  }
+} // namespace mockup
+
+#endif // MOCKUP_OVERLOAD_HPP
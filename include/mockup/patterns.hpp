@@ -0,0 +1,434 @@
+#ifndef MOCKUP_PATTERNS_HPP
+#define MOCKUP_PATTERNS_HPP
+
+#include <mockup/detail/member_function.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/mock.hpp>
+#include <mockup/mock_function.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mockup::detail
+{
+  // The log of one mocked member function, as seen by a pattern.
+  struct pattern_source
+  {
+    void const* identity;
+    std::function<std::size_t()> size;
+    std::function<std::size_t(std::size_t)> order;
+  };
+
+  // A call to one source with matching arguments.
+  struct pattern_atom
+  {
+    std::size_t source;
+    std::function<bool(std::size_t)> match;
+  };
+
+  struct pattern_transition
+  {
+    std::size_t atom;
+    std::size_t to;
+  };
+
+  // An NFA without epsilon transitions. Keeping the automaton epsilon-free lets
+  // interleaving be built as a plain product of its operands.
+  struct automaton
+  {
+    std::vector<pattern_source> sources;
+    std::vector<pattern_atom> atoms;
+    std::vector<std::vector<pattern_transition>> transitions;
+    std::vector<std::size_t> initial;
+    std::vector<std::size_t> accepting;
+
+    bool nullable() const
+    {
+      for (auto state : initial)
+      {
+        for (auto other : accepting)
+        {
+          if (state == other)
+          {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+  };
+
+  template <typename Instance, typename... Args>
+  automaton make_call_automaton(Instance& instance, Args&&... args)
+  {
+    automaton result;
+    result.sources.push_back(
+        {&instance,
+         [&instance]() {
+           return instance.invocations.size();
+         },
+         [&instance](std::size_t index) {
+           return instance.invocations.order(index);
+         }});
+    result.atoms.push_back(
+        {0,
+         [&instance, expected = std::make_tuple(std::forward<Args>(args)...)](
+             std::size_t index) {
+           return instance.invocations.match(index, [&](auto const&... args) {
+             return expected == std::tie(args...);
+           });
+         }});
+    result.transitions.resize(2);
+    result.transitions[0].push_back({0, 1});
+    result.initial = {0};
+    result.accepting = {1};
+    return result;
+  }
+
+  // Adds the sources and atoms of `from` to `into`, returning where each atom of `from`
+  // ended up.
+  inline std::vector<std::size_t> merge_alphabet(automaton& into, automaton const& from)
+  {
+    std::vector<std::size_t> sources;
+    for (auto const& source : from.sources)
+    {
+      auto index = std::size_t();
+      while (index < into.sources.size() && into.sources[index].identity != source.identity)
+      {
+        ++index;
+      }
+      if (index == into.sources.size())
+      {
+        into.sources.push_back(source);
+      }
+      sources.push_back(index);
+    }
+    std::vector<std::size_t> atoms;
+    for (auto const& atom : from.atoms)
+    {
+      atoms.push_back(into.atoms.size());
+      into.atoms.push_back({sources[atom.source], atom.match});
+    }
+    return atoms;
+  }
+
+  // Adds the alphabet and states of `from` to `into`, returning the offset of the
+  // added states.
+  inline std::size_t append(automaton& into, automaton const& from)
+  {
+    auto atoms = merge_alphabet(into, from);
+    auto offset = into.transitions.size();
+    for (auto const& transitions : from.transitions)
+    {
+      auto& added = into.transitions.emplace_back();
+      for (auto transition : transitions)
+      {
+        added.push_back({atoms[transition.atom], transition.to + offset});
+      }
+    }
+    return offset;
+  }
+
+  inline std::vector<std::size_t> shift(std::vector<std::size_t> states, std::size_t offset)
+  {
+    for (auto& state : states)
+    {
+      state += offset;
+    }
+    return states;
+  }
+
+  inline std::vector<pattern_transition>
+      outgoing(automaton const& a, std::vector<std::size_t> const& states)
+  {
+    std::vector<pattern_transition> result;
+    for (auto state : states)
+    {
+      result.insert(
+          std::end(result), std::begin(a.transitions[state]), std::end(a.transitions[state]));
+    }
+    return result;
+  }
+
+  inline automaton concatenate(automaton const& a, automaton const& b)
+  {
+    auto result = a;
+    auto offset = append(result, b);
+    auto initial = shift(b.initial, offset);
+    auto accepting = shift(b.accepting, offset);
+    auto starts = outgoing(result, initial);
+    for (auto state : a.accepting)
+    {
+      result.transitions[state].insert(
+          std::end(result.transitions[state]), std::begin(starts), std::end(starts));
+    }
+    if (a.nullable())
+    {
+      result.initial.insert(std::end(result.initial), std::begin(initial), std::end(initial));
+    }
+    if (!b.nullable())
+    {
+      result.accepting.clear();
+    }
+    result.accepting.insert(
+        std::end(result.accepting), std::begin(accepting), std::end(accepting));
+    return result;
+  }
+
+  inline automaton alternate(automaton const& a, automaton const& b)
+  {
+    auto result = a;
+    auto offset = append(result, b);
+    auto initial = shift(b.initial, offset);
+    auto accepting = shift(b.accepting, offset);
+    result.initial.insert(std::end(result.initial), std::begin(initial), std::end(initial));
+    result.accepting.insert(
+        std::end(result.accepting), std::begin(accepting), std::end(accepting));
+    return result;
+  }
+
+  inline automaton interleave(automaton const& a, automaton const& b)
+  {
+    automaton result;
+    result.sources = a.sources;
+    result.atoms = a.atoms;
+    auto atoms = merge_alphabet(result, b);
+    auto const width = b.transitions.size();
+    result.transitions.resize(a.transitions.size() * width);
+    for (std::size_t p = 0; p < a.transitions.size(); ++p)
+    {
+      for (std::size_t q = 0; q < width; ++q)
+      {
+        auto& transitions = result.transitions[p * width + q];
+        for (auto transition : a.transitions[p])
+        {
+          transitions.push_back({transition.atom, transition.to * width + q});
+        }
+        for (auto transition : b.transitions[q])
+        {
+          transitions.push_back({atoms[transition.atom], p * width + transition.to});
+        }
+      }
+    }
+    for (auto p : a.initial)
+    {
+      for (auto q : b.initial)
+      {
+        result.initial.push_back(p * width + q);
+      }
+    }
+    for (auto p : a.accepting)
+    {
+      for (auto q : b.accepting)
+      {
+        result.accepting.push_back(p * width + q);
+      }
+    }
+    return result;
+  }
+
+  inline automaton repeat(automaton a)
+  {
+    auto starts = outgoing(a, a.initial);
+    for (auto state : a.accepting)
+    {
+      a.transitions[state].insert(
+          std::end(a.transitions[state]), std::begin(starts), std::end(starts));
+    }
+    return a;
+  }
+
+  inline automaton optional(automaton a)
+  {
+    auto const state = a.transitions.size();
+    a.transitions.emplace_back();
+    a.initial.push_back(state);
+    a.accepting.push_back(state);
+    return a;
+  }
+
+  // Simulates the automaton over the calls to its sources, merged into global call
+  // order. Each call costs O(sources + active transitions), so the whole check is
+  // linear in the number of recorded calls.
+  inline bool run(automaton const& a)
+  {
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::vector<std::size_t>> source_atoms(a.sources.size());
+    for (std::size_t atom = 0; atom < a.atoms.size(); ++atom)
+    {
+      source_atoms[a.atoms[atom].source].push_back(atom);
+    }
+
+    std::vector<std::size_t> cursors(a.sources.size());
+    std::vector<std::size_t> sizes;
+    for (auto const& source : a.sources)
+    {
+      sizes.push_back(source.size());
+    }
+
+    enum class result : char
+    {
+      unknown,
+      match,
+      mismatch
+    };
+    std::vector<result> results(a.atoms.size());
+
+    std::vector<char> active(a.transitions.size());
+    std::vector<char> next(a.transitions.size());
+    std::vector<std::size_t> active_states;
+    std::vector<std::size_t> next_states;
+    for (auto state : a.initial)
+    {
+      if (!active[state])
+      {
+        active[state] = true;
+        active_states.push_back(state);
+      }
+    }
+
+    while (true)
+    {
+      auto source = none;
+      auto order = none;
+      for (std::size_t s = 0; s < a.sources.size(); ++s)
+      {
+        if (cursors[s] < sizes[s])
+        {
+          if (auto o = a.sources[s].order(cursors[s]); o < order)
+          {
+            source = s;
+            order = o;
+          }
+        }
+      }
+      if (source == none)
+      {
+        break;
+      }
+
+      for (auto atom : source_atoms[source])
+      {
+        results[atom] = result::unknown;
+      }
+
+      next_states.clear();
+      for (auto state : active_states)
+      {
+        for (auto transition : a.transitions[state])
+        {
+          auto const& atom = a.atoms[transition.atom];
+          if (atom.source != source || next[transition.to])
+          {
+            continue;
+          }
+          if (results[transition.atom] == result::unknown)
+          {
+            results[transition.atom] =
+                atom.match(cursors[source]) ? result::match : result::mismatch;
+          }
+          if (results[transition.atom] == result::match)
+          {
+            next[transition.to] = true;
+            next_states.push_back(transition.to);
+          }
+        }
+        active[state] = false;
+      }
+
+      if (next_states.empty())
+      {
+        return false;
+      }
+
+      std::swap(active, next);
+      std::swap(active_states, next_states);
+      ++cursors[source];
+    }
+
+    for (auto state : a.accepting)
+    {
+      if (active[state])
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // A regular-expression-like pattern over the calls made to a set of mocked
+  // functions. A pattern matches when the calls made to the functions it mentions,
+  // taken in global call order, form a word of the pattern's language; calls to other
+  // functions are ignored. A pattern refers to the mocks it was built on and does not
+  // keep them alive, so it must not be checked after any of them is destroyed.
+  struct pattern
+  {
+    detail::automaton automaton;
+  };
+
+  template <auto MemberFunction, typename Mock, typename... Args>
+  pattern call(mock<Mock>& mock, Args&&... args)
+  {
+    return {detail::make_call_automaton(
+        detail::get_member_function_instance<MemberFunction>(mock.operator->()),
+        std::forward<Args>(args)...)};
+  }
+
+  template <typename Signature, typename... Args>
+  pattern call(mock_function<Signature>& function, Args&&... args)
+  {
+    return {detail::make_call_automaton(
+        detail::mock_function_access::instance(function), std::forward<Args>(args)...)};
+  }
+
+  template <typename... Patterns>
+  pattern then(pattern first, Patterns const&... rest)
+  {
+    (..., (first.automaton = detail::concatenate(first.automaton, rest.automaton)));
+    return first;
+  }
+
+  template <typename... Patterns>
+  pattern either(pattern first, Patterns const&... rest)
+  {
+    (..., (first.automaton = detail::alternate(first.automaton, rest.automaton)));
+    return first;
+  }
+
+  template <typename... Patterns>
+  pattern interleaved(pattern first, Patterns const&... rest)
+  {
+    (..., (first.automaton = detail::interleave(first.automaton, rest.automaton)));
+    return first;
+  }
+
+  inline pattern one_or_more(pattern p)
+  {
+    return {detail::repeat(std::move(p.automaton))};
+  }
+
+  inline pattern zero_or_more(pattern p)
+  {
+    return {detail::optional(detail::repeat(std::move(p.automaton)))};
+  }
+
+  inline pattern maybe(pattern p)
+  {
+    return {detail::optional(std::move(p.automaton))};
+  }
+
+  inline bool matches(pattern const& p)
+  {
+    return detail::run(p.automaton);
+  }
+} // namespace mockup
+
+#endif // MOCKUP_PATTERNS_HPP
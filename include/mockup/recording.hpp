@@ -0,0 +1,264 @@
+#ifndef MOCKUP_RECORDING_HPP
+#define MOCKUP_RECORDING_HPP
+
+#include <mockup/detail/hash.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/serializer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mockup::detail
+{
+  // The calls seen by a spy: each distinct argument tuple, in the order first seen, with
+  // the results returned for it in call order. Tuples of hashable arguments are found
+  // through a hash index, others by comparing them in turn.
+  template <typename R, typename... Args>
+  struct recording_state
+  {
+    using key_type = std::tuple<std::decay_t<Args>...>;
+    using result_type = std::conditional_t<std::is_void_v<R>, std::tuple<>, std::decay_t<R>>;
+
+    static constexpr bool is_indexed = (... && is_hashable_v<std::decay_t<Args>>);
+
+    std::vector<std::pair<key_type, std::vector<result_type>>> entries;
+    std::unordered_multimap<std::size_t, std::size_t> index;
+
+    template <typename... Values>
+    std::optional<std::size_t> find(Values const&... values) const
+    {
+      if constexpr (is_indexed)
+      {
+        auto [first, last] = index.equal_range(hash_values<std::decay_t<Args>...>(values...));
+        for (; first != last; ++first)
+        {
+          if (entries[first->second].first == std::tie(values...))
+          {
+            return first->second;
+          }
+        }
+      }
+      else
+      {
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+          if (entries[i].first == std::tie(values...))
+          {
+            return i;
+          }
+        }
+      }
+      return std::nullopt;
+    }
+
+    // The results recorded for `values`, added if there are none yet.
+    template <typename... Values>
+    std::vector<result_type>& results(Values const&... values)
+    {
+      if (auto const i = find(values...))
+      {
+        return entries[*i].second;
+      }
+      return add(key_type(values...));
+    }
+
+    std::vector<result_type>& add(key_type key)
+    {
+      if constexpr (is_indexed)
+      {
+        index.emplace(std::apply(hash_values<std::decay_t<Args>...>, key), entries.size());
+      }
+      entries.emplace_back(std::move(key), std::vector<result_type>());
+      return entries.back().second;
+    }
+  };
+
+  // A recording starts with a magic number, a version and the value 0x01020304, then the
+  // number of argument tuples. Each tuple is followed by the number of calls made with it
+  // and their results.
+  constexpr char recording_magic[4] = {'M', 'K', 'R', 'C'};
+  constexpr std::uint32_t recording_version = 1;
+  constexpr std::uint32_t recording_byte_order = 0x01020304;
+
+  struct recording_access
+  {
+    template <typename Signature>
+    static auto const& state(recording<Signature> const& rec)
+    {
+      return rec.m_state;
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // The arguments and results of the calls made through a `spy`, to be served by
+  // `replay`. Copies share their calls.
+  template <typename R, typename... Args>
+  class recording<R(Args...)>
+  {
+  private:
+    static_assert(
+        (... && std::is_copy_constructible_v<std::decay_t<Args>>) &&
+            (std::is_void_v<R> || std::is_copy_constructible_v<std::decay_t<R>>),
+        "recorded arguments and results must be copyable");
+
+    using state_type = detail::recording_state<R, Args...>;
+
+    std::shared_ptr<state_type> m_state = std::make_shared<state_type>();
+
+    friend struct detail::recording_access;
+
+  public:
+    recording() = default;
+
+    // Loads a recording written by `save`. Arguments and results are read with
+    // `serializer`.
+    explicit recording(std::istream& in)
+    {
+      char magic[sizeof(detail::recording_magic)];
+      if (!in.read(magic, sizeof(magic)) ||
+          !std::equal(std::begin(magic), std::end(magic), std::begin(detail::recording_magic)) ||
+          detail::read_raw<std::uint32_t>(in) != detail::recording_version ||
+          detail::read_raw<std::uint32_t>(in) != detail::recording_byte_order)
+      {
+        throw std::runtime_error(
+            "mockup: not a recording written by this version on this machine");
+      }
+      auto const entries = detail::read_raw<std::uint64_t>(in);
+      for (std::uint64_t i = 0; i < entries; ++i)
+      {
+        // Braced initialization reads the arguments in order.
+        typename state_type::key_type key{serializer<std::decay_t<Args>>::read(in)...};
+        auto& results = m_state->add(std::move(key));
+        auto const calls = detail::read_raw<std::uint64_t>(in);
+        if (calls == 0)
+        {
+          // `save` writes only arguments that were called with, and `replay` serves
+          // the results of each.
+          throw std::runtime_error("mockup: recording has arguments with no calls");
+        }
+        for (std::uint64_t j = 0; j < calls; ++j)
+        {
+          if constexpr (std::is_void_v<R>)
+          {
+            results.emplace_back();
+          }
+          else
+          {
+            results.push_back(serializer<std::decay_t<R>>::read(in));
+          }
+        }
+      }
+    }
+
+    // Writes the recorded calls, so that later runs can replay them without the real
+    // implementation.
+    void save(std::ostream& out) const
+    {
+      out.write(detail::recording_magic, sizeof(detail::recording_magic));
+      detail::write_raw(out, detail::recording_version);
+      detail::write_raw(out, detail::recording_byte_order);
+      detail::write_raw(out, static_cast<std::uint64_t>(m_state->entries.size()));
+      for (auto const& [key, results] : m_state->entries)
+      {
+        std::apply(
+            [&](auto const&... args) {
+              (..., serializer<std::decay_t<decltype(args)>>::write(out, args));
+            },
+            key);
+        detail::write_raw(out, static_cast<std::uint64_t>(results.size()));
+        if constexpr (!std::is_void_v<R>)
+        {
+          for (auto const& result : results)
+          {
+            serializer<std::decay_t<R>>::write(out, result);
+          }
+        }
+      }
+      if (!out)
+      {
+        throw std::runtime_error("mockup: cannot write recording");
+      }
+    }
+
+    // The number of calls recorded.
+    std::size_t size() const
+    {
+      std::size_t result = 0;
+      for (auto const& entry : m_state->entries)
+      {
+        result += entry.second.size();
+      }
+      return result;
+    }
+
+    bool empty() const
+    {
+      return m_state->entries.empty();
+    }
+  };
+
+  namespace helpers
+  {
+    // Forwards each call to `real`, then records its arguments and result in `rec`.
+    template <typename R, typename... Args, typename F>
+    auto spy(recording<R(Args...)>& rec, F&& real)
+    {
+      return [state = detail::recording_access::state(rec),
+              real = std::forward<F>(real)](auto&&... args) mutable -> R {
+        if constexpr (std::is_void_v<R>)
+        {
+          std::invoke(real, args...);
+          state->results(args...).emplace_back();
+        }
+        else
+        {
+          R result = std::invoke(real, args...);
+          state->results(args...).push_back(result);
+          return std::forward<R>(result);
+        }
+      };
+    }
+
+    // Serves the results recorded in `rec` without calling the real implementation: the
+    // n-th call with some arguments returns the n-th result recorded for them, and the
+    // last one once they run out. Throws `std::out_of_range` for arguments that were
+    // never recorded.
+    template <typename R, typename... Args>
+    auto replay(recording<R(Args...)> const& rec)
+    {
+      return [state = detail::recording_access::state(rec),
+              next = std::vector<std::size_t>()](auto const&... args) mutable -> R {
+        auto const i = state->find(args...);
+        if (!i)
+        {
+          throw std::out_of_range("mockup: no recorded call with these arguments");
+        }
+        if constexpr (!std::is_void_v<R>)
+        {
+          next.resize(state->entries.size());
+          auto& results = state->entries[*i].second;
+          return static_cast<R>(results[std::min(next[*i]++, results.size() - 1)]);
+        }
+      };
+    }
+  } // namespace helpers
+
+  using namespace helpers;
+} // namespace mockup
+
+#endif // MOCKUP_RECORDING_HPP
@@ -0,0 +1,29 @@
+#ifndef MOCKUP_SEQUENCE_HPP
+#define MOCKUP_SEQUENCE_HPP
+
+#include <mockup/detail/order.hpp>
+#include <mockup/fwd.hpp>
+
+#include <cstddef>
+
+namespace mockup
+{
+  struct sequence
+  {
+    std::size_t order = 0;
+  };
+
+  // A point in the global call order. Calls made after the checkpoint was taken have a
+  // greater order, so checks can be restricted to the calls between two checkpoints.
+  struct checkpoint_t
+  {
+    std::size_t order = 0;
+  };
+
+  inline checkpoint_t checkpoint()
+  {
+    return {detail::order};
+  }
+} // namespace mockup
+
+#endif // MOCKUP_SEQUENCE_HPP
@@ -0,0 +1,84 @@
+#ifndef MOCKUP_SERIALIZER_HPP
+#define MOCKUP_SERIALIZER_HPP
+
+#include <mockup/fwd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace mockup
+{
+  // Writes and reads values of type `T` in traces and recordings. Specialize it for other
+  // types; arithmetic types, enumerations and `std::string` are provided.
+  template <typename T, typename Enable>
+  struct serializer
+  {
+    static_assert(
+        !std::is_same_v<T, T>, "specialize mockup::serializer to serialize values of this type");
+  };
+
+  // Arithmetic types and enumerations are written as their bytes, in the byte order of
+  // the machine.
+  template <typename T>
+  struct serializer<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+  {
+    static void write(std::ostream& out, T const& value)
+    {
+      out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+    }
+
+    static T read(std::istream& in)
+    {
+      T value;
+      if (!in.read(reinterpret_cast<char*>(&value), sizeof(value)))
+      {
+        throw std::runtime_error("mockup: input is truncated");
+      }
+      return value;
+    }
+  };
+
+  template <>
+  struct serializer<std::string>
+  {
+    static void write(std::ostream& out, std::string const& value)
+    {
+      serializer<std::uint64_t>::write(out, value.size());
+      out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    static std::string read(std::istream& in)
+    {
+      auto const size = serializer<std::uint64_t>::read(in);
+      std::string value;
+      value.resize(static_cast<std::size_t>(size));
+      if (!in.read(value.data(), static_cast<std::streamsize>(size)))
+      {
+        throw std::runtime_error("mockup: input is truncated");
+      }
+      return value;
+    }
+  };
+} // namespace mockup
+
+namespace mockup::detail
+{
+  template <typename T>
+  void write_raw(std::ostream& out, T const& value)
+  {
+    serializer<T>::write(out, value);
+  }
+
+  template <typename T>
+  T read_raw(std::istream& in)
+  {
+    return serializer<T>::read(in);
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_SERIALIZER_HPP
@@ -0,0 +1,24 @@
+#ifndef MOCKUP_SPILL_HPP
+#define MOCKUP_SPILL_HPP
+
+#include <mockup/detail/mapped_file.hpp>
+#include <mockup/detail/spill_storage.hpp>
+#include <mockup/fwd.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mockup::detail
+{
+  // Spilled invocations are written to memory-mapped files.
+  template <typename>
+  struct spill_file
+  {
+    static std::unique_ptr<spill_storage> open(std::string const& path, bool keep)
+    {
+      return std::make_unique<mapped_file>(path, keep);
+    }
+  };
+} // namespace mockup::detail
+
+#endif // MOCKUP_SPILL_HPP
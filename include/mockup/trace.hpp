@@ -0,0 +1,352 @@
+#ifndef MOCKUP_TRACE_HPP
+#define MOCKUP_TRACE_HPP
+
+#include <mockup/detail/invocation_log.hpp>
+#include <mockup/detail/member_function.hpp>
+#include <mockup/detail/operations.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/invocations.hpp>
+#include <mockup/mock.hpp>
+#include <mockup/mock_function.hpp>
+#include <mockup/sequence.hpp>
+#include <mockup/serializer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mockup::detail
+{
+  // A trace starts with a magic number, a version and the value 0x01020304, so that a
+  // trace written on a machine of another byte order is rejected. Then come records of
+  // a kind, a payload length and the payload. A function record names the function with
+  // an ID; a call record holds the function ID, the order of the call and its arguments.
+  constexpr char trace_magic[4] = {'M', 'K', 'T', 'R'};
+  constexpr std::uint32_t trace_version = 1;
+  constexpr std::uint32_t trace_byte_order = 0x01020304;
+
+  enum class trace_record : std::uint8_t
+  {
+    function = 1,
+    call = 2
+  };
+
+  template <typename... Args>
+  struct trace_instance
+  {
+    invocation_log<Args...> invocations;
+  };
+
+  template <typename... Args>
+  void write_arguments(std::ostream& out, Args const&... args)
+  {
+    (..., serializer<std::decay_t<Args>>::write(out, args));
+  }
+
+  // Reads the calls of a trace one record at a time, so that a trace of any length can
+  // be streamed. Only the names of the functions are kept.
+  class trace_reader
+  {
+  public:
+    struct call
+    {
+      std::string const* function = nullptr;
+      std::uint64_t order = 0;
+      std::string arguments;
+    };
+
+  private:
+    std::istream* m_in;
+    std::map<std::uint32_t, std::string> m_functions;
+    std::string m_payload;
+
+  public:
+    explicit trace_reader(std::istream& in)
+    : m_in(&in)
+    {
+      char magic[sizeof(trace_magic)];
+      if (!in.read(magic, sizeof(magic)) ||
+          !std::equal(std::begin(magic), std::end(magic), std::begin(trace_magic)) ||
+          read_raw<std::uint32_t>(in) != trace_version ||
+          read_raw<std::uint32_t>(in) != trace_byte_order)
+      {
+        throw std::runtime_error("mockup: not a trace written by this version on this machine");
+      }
+    }
+
+    // Reads up to the next call record into `result`. Returns false at the end of the
+    // trace.
+    bool next(call& result)
+    {
+      while (m_in->peek() != std::istream::traits_type::eof())
+      {
+        auto const kind = trace_record(read_raw<std::uint8_t>(*m_in));
+        m_payload.resize(read_raw<std::uint32_t>(*m_in));
+        if (!m_in->read(m_payload.data(), static_cast<std::streamsize>(m_payload.size())) ||
+            m_payload.size() < sizeof(std::uint32_t))
+        {
+          throw std::runtime_error("mockup: trace is truncated");
+        }
+        std::uint32_t id;
+        std::copy_n(m_payload.data(), sizeof(id), reinterpret_cast<char*>(&id));
+        if (kind == trace_record::function)
+        {
+          m_functions[id] = m_payload.substr(sizeof(id));
+        }
+        else if (kind == trace_record::call)
+        {
+          auto const it = m_functions.find(id);
+          if (it == m_functions.end() || m_payload.size() < sizeof(id) + sizeof(result.order))
+          {
+            throw std::runtime_error("mockup: trace call to an undeclared function");
+          }
+          result.function = &it->second;
+          std::copy_n(
+              m_payload.data() + sizeof(id),
+              sizeof(result.order),
+              reinterpret_cast<char*>(&result.order));
+          result.arguments.assign(m_payload, sizeof(id) + sizeof(result.order));
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // The functions declared so far, by ID.
+    std::map<std::uint32_t, std::string> const& functions() const
+    {
+      return m_functions;
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // Writes the recorded calls of mocked functions to a binary trace, to be loaded later
+  // with `trace`.
+  class trace_writer
+  {
+  private:
+    std::ostream* m_out;
+    std::map<std::string, std::uint32_t> m_functions;
+    std::ostringstream m_payload;
+
+    void write_record(detail::trace_record kind)
+    {
+      auto const payload = m_payload.str();
+      detail::write_raw(*m_out, static_cast<std::uint8_t>(kind));
+      detail::write_raw(*m_out, static_cast<std::uint32_t>(payload.size()));
+      m_out->write(payload.data(), static_cast<std::streamsize>(payload.size()));
+      m_payload.str({});
+    }
+
+    std::uint32_t function_id(std::string const& name)
+    {
+      auto [it, inserted] =
+          m_functions.emplace(name, static_cast<std::uint32_t>(m_functions.size()));
+      if (inserted)
+      {
+        detail::write_raw(m_payload, it->second);
+        m_payload.write(name.data(), static_cast<std::streamsize>(name.size()));
+        write_record(detail::trace_record::function);
+      }
+      return it->second;
+    }
+
+    template <typename... Args>
+    void write_call(std::uint32_t id, std::size_t order, Args const&... args)
+    {
+      detail::write_raw(m_payload, id);
+      detail::write_raw(m_payload, static_cast<std::uint64_t>(order));
+      detail::write_arguments(m_payload, args...);
+      write_record(detail::trace_record::call);
+    }
+
+    template <typename R, typename... Args>
+    void follow(std::string const& name, detail::member_function_instance<R(Args...)>& instance)
+    {
+      instance.observers.emplace_back(
+          [this, id = function_id(name)](std::size_t order, auto const&... args) {
+            write_call(id, order, args...);
+            if (!*m_out)
+            {
+              throw std::runtime_error("mockup: cannot write trace");
+            }
+          });
+    }
+
+  public:
+    explicit trace_writer(std::ostream& out)
+    : m_out(&out)
+    {
+      m_out->write(detail::trace_magic, sizeof(detail::trace_magic));
+      detail::write_raw(*m_out, detail::trace_version);
+      detail::write_raw(*m_out, detail::trace_byte_order);
+    }
+
+    // Writes the calls in `calls`, such as `m.invocations<&T::f>()`, as calls to the
+    // function `name`. Arguments are written with `serializer`.
+    template <typename Log, typename Filter>
+    void write(std::string const& name, invocation_view<Log, Filter> const& calls)
+    {
+      auto const id = function_id(name);
+      for (auto const& call : calls)
+      {
+        std::apply(
+            [&](auto const&... args) { write_call(id, call.order(), args...); }, call.arguments());
+      }
+      if (!*m_out)
+      {
+        throw std::runtime_error("mockup: cannot write trace");
+      }
+    }
+
+    // Writes each call to `MemberFunction` of `mock` as it is made, as a call to the
+    // function `name`, so that calls to several functions are written in the order they
+    // are made and nothing is kept in memory. Works with recording disabled. The writer
+    // must outlive the calls.
+    template <auto MemberFunction, typename Mock>
+    void follow(std::string const& name, mock<Mock>& mock)
+    {
+      follow(name, detail::get_member_function_instance<MemberFunction>(mock.operator->()));
+    }
+
+    template <typename Signature>
+    void follow(std::string const& name, mock_function<Signature>& function)
+    {
+      follow(name, detail::mock_function_access::instance(function));
+    }
+  };
+
+  // The calls to one function of a loaded trace, which can be queried as the calls to a
+  // mock are.
+  template <typename R, typename... Args>
+  class trace_log<R(Args...)>
+  {
+  private:
+    static_assert(
+        (... &&
+         (std::is_copy_constructible_v<std::decay_t<Args>> || detail::owns_argument_v<Args>)),
+        "traced arguments must be stored by value");
+
+    detail::trace_instance<Args...> m_instance;
+
+    friend class trace;
+
+    template <typename... Values>
+    void push_back(std::size_t order, Values&&... values)
+    {
+      m_instance.invocations.push_back(order, std::forward<Values>(values)...);
+    }
+
+  public:
+    template <typename... Matchers>
+    bool invoked(Matchers const&... matchers) const
+    {
+      return detail::invoked(m_instance, matchers...);
+    }
+
+    template <typename... Matchers>
+    bool invoked(sequence& seq, Matchers const&... matchers) const
+    {
+      return detail::invoked(m_instance, seq, matchers...);
+    }
+
+    template <typename... Matchers>
+    std::size_t times(Matchers const&... matchers) const
+    {
+      return detail::times_between(m_instance, 0, detail::end_of_order, matchers...);
+    }
+
+    auto invocations() const
+    {
+      return invocation_view<detail::invocation_log<Args...>>(m_instance.invocations);
+    }
+  };
+
+  // A binary trace written by `trace_writer`. The calls to each function are decoded
+  // when they are asked for, with the signature given then.
+  class trace
+  {
+  private:
+    struct call
+    {
+      std::uint64_t order;
+      std::string arguments;
+    };
+
+    std::map<std::string, std::vector<call>> m_functions;
+
+  public:
+    explicit trace(std::istream& in)
+    {
+      detail::trace_reader reader(in);
+      detail::trace_reader::call next;
+      while (reader.next(next))
+      {
+        m_functions[*next.function].push_back({next.order, std::move(next.arguments)});
+      }
+      for (auto const& function : reader.functions())
+      {
+        m_functions[function.second];
+      }
+    }
+
+    // The names of the traced functions.
+    std::vector<std::string> functions() const
+    {
+      std::vector<std::string> result;
+      for (auto const& function : m_functions)
+      {
+        result.push_back(function.first);
+      }
+      return result;
+    }
+
+    // The calls to function `name`, whose arguments are read as those of `Signature`.
+    // Throws `std::out_of_range` if the function was not traced, and
+    // `std::runtime_error` if a call does not match the signature.
+    template <typename Signature>
+    trace_log<Signature> function(std::string const& name) const
+    {
+      trace_log<Signature> result;
+      read(result, m_functions.at(name));
+      return result;
+    }
+
+  private:
+    template <typename R, typename... Args>
+    static void read(trace_log<R(Args...)>& log, std::vector<call> const& calls)
+    {
+      std::istringstream in;
+      for (auto const& call : calls)
+      {
+        in.str(call.arguments);
+        in.clear();
+        std::tuple<std::decay_t<Args>...> values{serializer<std::decay_t<Args>>::read(in)...};
+        if (in.peek() != std::istream::traits_type::eof())
+        {
+          throw std::runtime_error("mockup: trace call does not match the signature");
+        }
+        std::apply(
+            [&](auto&... values) {
+              log.push_back(static_cast<std::size_t>(call.order), std::move(values)...);
+            },
+            values);
+      }
+    }
+  };
+} // namespace mockup
+
+#endif // MOCKUP_TRACE_HPP
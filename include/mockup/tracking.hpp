@@ -0,0 +1,150 @@
+#ifndef MOCKUP_TRACKING_HPP
+#define MOCKUP_TRACKING_HPP
+
+#include <mockup/detail/member_function.hpp>
+#include <mockup/detail/sum.hpp>
+#include <mockup/fwd.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace mockup::detail
+{
+  template <typename T>
+  struct tracked_state
+  {
+    std::size_t count = 0;
+    sum_t<T> sum{};
+    std::optional<T> min;
+    std::optional<T> max;
+  };
+
+  template <typename T>
+  struct tracked_histogram_state
+  {
+    std::size_t count = 0;
+    std::map<T, std::size_t> histogram;
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // The count, sum, minimum and maximum of one argument of a member function, updated
+  // as the calls are made. Tracking works with recording disabled, so totals over very
+  // many calls cost no memory.
+  template <typename T>
+  class tracked
+  {
+  private:
+    std::shared_ptr<detail::tracked_state<T>> m_state;
+
+  public:
+    explicit tracked(std::shared_ptr<detail::tracked_state<T>> state)
+    : m_state(std::move(state))
+    {
+    }
+
+    std::size_t count() const
+    {
+      return m_state->count;
+    }
+
+    auto const& sum() const
+    {
+      return m_state->sum;
+    }
+
+    T const& min() const
+    {
+      if (!m_state->min)
+      {
+        throw std::out_of_range("tracked::min");
+      }
+      return *m_state->min;
+    }
+
+    T const& max() const
+    {
+      if (!m_state->max)
+      {
+        throw std::out_of_range("tracked::max");
+      }
+      return *m_state->max;
+    }
+  };
+
+  // The number of calls made with each value of one argument of a member function,
+  // updated as the calls are made.
+  template <typename T>
+  class tracked_histogram
+  {
+  private:
+    std::shared_ptr<detail::tracked_histogram_state<T>> m_state;
+
+  public:
+    explicit tracked_histogram(std::shared_ptr<detail::tracked_histogram_state<T>> state)
+    : m_state(std::move(state))
+    {
+    }
+
+    std::size_t count() const
+    {
+      return m_state->count;
+    }
+
+    std::map<T, std::size_t> const& histogram() const
+    {
+      return m_state->histogram;
+    }
+
+    std::size_t distinct_count() const
+    {
+      return m_state->histogram.size();
+    }
+  };
+} // namespace mockup
+
+namespace mockup::detail
+{
+  template <std::size_t I, typename R, typename... Args>
+  tracked<decayed_argument_t<I, Args...>> track(member_function_instance<R(Args...)>& instance)
+  {
+    using T = decayed_argument_t<I, Args...>;
+    auto state = std::make_shared<tracked_state<T>>();
+    instance.observers.emplace_back([state](std::size_t, auto const&... args) {
+      auto const& value = std::get<I>(std::tie(args...));
+      ++state->count;
+      state->sum += value;
+      if (!state->min || value < *state->min)
+      {
+        state->min = value;
+      }
+      if (!state->max || *state->max < value)
+      {
+        state->max = value;
+      }
+    });
+    return tracked<T>(std::move(state));
+  }
+
+  template <std::size_t I, typename R, typename... Args>
+  tracked_histogram<decayed_argument_t<I, Args...>> track_histogram(
+      member_function_instance<R(Args...)>& instance)
+  {
+    using T = decayed_argument_t<I, Args...>;
+    auto state = std::make_shared<tracked_histogram_state<T>>();
+    instance.observers.emplace_back([state](std::size_t, auto const&... args) {
+      ++state->count;
+      ++state->histogram[std::get<I>(std::tie(args...))];
+    });
+    return tracked_histogram<T>(std::move(state));
+  }
+} // namespace mockup::detail
+
+#endif // MOCKUP_TRACKING_HPP
@@ -0,0 +1,368 @@
+#ifndef MOCKUP_VERIFIER_HPP
+#define MOCKUP_VERIFIER_HPP
+
+#include <mockup/detail/hash.hpp>
+#include <mockup/detail/member_function.hpp>
+#include <mockup/fwd.hpp>
+#include <mockup/mock.hpp>
+#include <mockup/mock_function.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mockup
+{
+  struct verification_result
+  {
+    bool passed = false;
+    std::size_t count = 0;
+  };
+
+  class verification_report
+  {
+  private:
+    std::vector<verification_result> m_results;
+
+  public:
+    explicit verification_report(std::vector<verification_result> results)
+    : m_results(std::move(results))
+    {
+    }
+
+    bool passed() const
+    {
+      for (auto const& result : m_results)
+      {
+        if (!result.passed)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    std::vector<std::size_t> failures() const
+    {
+      std::vector<std::size_t> result;
+      for (std::size_t i = 0; i < m_results.size(); ++i)
+      {
+        if (!m_results[i].passed)
+        {
+          result.push_back(i);
+        }
+      }
+      return result;
+    }
+
+    std::size_t size() const
+    {
+      return m_results.size();
+    }
+
+    verification_result const& operator[](std::size_t index) const
+    {
+      return m_results[index];
+    }
+  };
+} // namespace mockup
+
+namespace mockup::detail
+{
+  struct verification_check
+  {
+    std::size_t min;
+    std::size_t max;
+  };
+
+  template <typename>
+  struct verification_group;
+
+  // The checks on one member function. Checks whose arguments are all plain values of
+  // the parameter types are looked up by hash, so each recorded invocation costs one
+  // lookup plus one call per remaining (matcher-based) check.
+  template <typename R, typename... Args>
+  struct verification_group<R(Args...)>
+  {
+    using key_type = std::tuple<std::decay_t<Args>...>;
+
+    static constexpr bool hashable = (... && is_hashable_v<std::decay_t<Args>>);
+
+    member_function_instance<R(Args...)> const* instance;
+    std::vector<std::pair<key_type, std::vector<std::size_t>>> keys;
+    std::unordered_multimap<std::size_t, std::size_t> index;
+    std::vector<std::pair<std::size_t, std::function<bool(matchable_t<Args> const&...)>>>
+        general;
+
+    template <typename... Matchers>
+    void add(std::size_t check, Matchers&&... matchers)
+    {
+      if constexpr (
+          hashable && (... && std::is_same_v<std::decay_t<Matchers>, std::decay_t<Args>>))
+      {
+        auto const hash = hash_values(matchers...);
+        auto [begin, end] = index.equal_range(hash);
+        for (auto it = begin; it != end; ++it)
+        {
+          if (keys[it->second].first == std::tie(matchers...))
+          {
+            keys[it->second].second.push_back(check);
+            return;
+          }
+        }
+        index.emplace(hash, keys.size());
+        keys.emplace_back(key_type(std::forward<Matchers>(matchers)...), std::vector{check});
+      }
+      else
+      {
+        general.emplace_back(
+            check,
+            [expected = std::make_tuple(std::forward<Matchers>(matchers)...)](
+                matchable_t<Args> const&... args) {
+              return expected == std::tie(args...);
+            });
+      }
+    }
+
+    void run(std::vector<verification_result>& results) const
+    {
+      auto const& log = instance->invocations;
+      for (std::size_t i = 0; i < log.size(); ++i)
+      {
+        if constexpr (hashable)
+        {
+          if (!keys.empty())
+          {
+            if (log.has_values(i))
+            {
+              std::apply(
+                  [&](auto const&... args) {
+                    auto [begin, end] = index.equal_range(hash_values(args...));
+                    for (auto it = begin; it != end; ++it)
+                    {
+                      if (keys[it->second].first == std::tie(args...))
+                      {
+                        count(keys[it->second].second, results);
+                      }
+                    }
+                  },
+                  log.arguments(i));
+            }
+            else
+            {
+              // Arguments stored by projection cannot be hashed, so each key is
+              // compared in turn.
+              log.match(i, [&](auto const&... args) {
+                for (auto const& [key, checks] : keys)
+                {
+                  if (key == std::tie(args...))
+                  {
+                    count(checks, results);
+                  }
+                }
+                return false;
+              });
+            }
+          }
+        }
+        if (!general.empty())
+        {
+          log.match(i, [&](auto const&... args) {
+            for (auto const& [check, matches] : general)
+            {
+              if (matches(args...))
+              {
+                ++results[check].count;
+              }
+            }
+            return false;
+          });
+        }
+      }
+    }
+
+    static void count(
+        std::vector<std::size_t> const& checks, std::vector<verification_result>& results)
+    {
+      for (auto check : checks)
+      {
+        ++results[check].count;
+      }
+    }
+  };
+} // namespace mockup::detail
+
+namespace mockup
+{
+  // Collects checks on recorded invocations and evaluates them together, making one
+  // pass over the log of each member function however many checks refer to it.
+  class verifier
+  {
+  private:
+    struct group
+    {
+      void const* identity;
+      std::shared_ptr<void> state;
+      std::function<void(std::vector<verification_result>&)> run;
+    };
+
+    std::vector<detail::verification_check> m_checks;
+    std::vector<group> m_groups;
+
+    template <typename R, typename... Args, typename... Matchers>
+    std::size_t add(
+        detail::member_function_instance<R(Args...)> const& instance,
+        std::size_t min,
+        std::size_t max,
+        Matchers&&... matchers)
+    {
+      using state_type = detail::verification_group<R(Args...)>;
+
+      auto it = m_groups.begin();
+      while (it != m_groups.end() && it->identity != &instance)
+      {
+        ++it;
+      }
+      if (it == m_groups.end())
+      {
+        auto state = std::make_shared<state_type>();
+        state->instance = &instance;
+        m_groups.push_back({&instance, state, [state](auto& results) {
+                              state->run(results);
+                            }});
+        it = std::prev(m_groups.end());
+      }
+
+      auto const check = m_checks.size();
+      m_checks.push_back({min, max});
+      std::static_pointer_cast<state_type>(it->state)
+          ->add(check, std::forward<Matchers>(matchers)...);
+      return check;
+    }
+
+    static constexpr auto unbounded = static_cast<std::size_t>(-1);
+
+  public:
+    template <auto MemberFunction, typename Mock, typename... Args>
+    std::size_t invoked(mock<Mock>& mock, Args&&... args)
+    {
+      return add(
+          detail::get_member_function_instance<MemberFunction>(mock.operator->()),
+          1,
+          unbounded,
+          std::forward<Args>(args)...);
+    }
+
+    template <auto MemberFunction, typename Mock, typename... Args>
+    std::size_t never(mock<Mock>& mock, Args&&... args)
+    {
+      return add(
+          detail::get_member_function_instance<MemberFunction>(mock.operator->()),
+          0,
+          0,
+          std::forward<Args>(args)...);
+    }
+
+    template <auto MemberFunction, typename Mock, typename... Args>
+    std::size_t times(mock<Mock>& mock, std::size_t n, Args&&... args)
+    {
+      return add(
+          detail::get_member_function_instance<MemberFunction>(mock.operator->()),
+          n,
+          n,
+          std::forward<Args>(args)...);
+    }
+
+    template <auto MemberFunction, typename Mock, typename... Args>
+    std::size_t at_least(mock<Mock>& mock, std::size_t n, Args&&... args)
+    {
+      return add(
+          detail::get_member_function_instance<MemberFunction>(mock.operator->()),
+          n,
+          unbounded,
+          std::forward<Args>(args)...);
+    }
+
+    template <auto MemberFunction, typename Mock, typename... Args>
+    std::size_t at_most(mock<Mock>& mock, std::size_t n, Args&&... args)
+    {
+      return add(
+          detail::get_member_function_instance<MemberFunction>(mock.operator->()),
+          0,
+          n,
+          std::forward<Args>(args)...);
+    }
+
+    template <typename Signature, typename... Args>
+    std::size_t invoked(mock_function<Signature>& function, Args&&... args)
+    {
+      return add(
+          detail::mock_function_access::instance(function),
+          1,
+          unbounded,
+          std::forward<Args>(args)...);
+    }
+
+    template <typename Signature, typename... Args>
+    std::size_t never(mock_function<Signature>& function, Args&&... args)
+    {
+      return add(
+          detail::mock_function_access::instance(function),
+          0,
+          0,
+          std::forward<Args>(args)...);
+    }
+
+    template <typename Signature, typename... Args>
+    std::size_t times(mock_function<Signature>& function, std::size_t n, Args&&... args)
+    {
+      return add(
+          detail::mock_function_access::instance(function),
+          n,
+          n,
+          std::forward<Args>(args)...);
+    }
+
+    template <typename Signature, typename... Args>
+    std::size_t at_least(mock_function<Signature>& function, std::size_t n, Args&&... args)
+    {
+      return add(
+          detail::mock_function_access::instance(function),
+          n,
+          unbounded,
+          std::forward<Args>(args)...);
+    }
+
+    template <typename Signature, typename... Args>
+    std::size_t at_most(mock_function<Signature>& function, std::size_t n, Args&&... args)
+    {
+      return add(
+          detail::mock_function_access::instance(function),
+          0,
+          n,
+          std::forward<Args>(args)...);
+    }
+
+    verification_report verify() const
+    {
+      std::vector<verification_result> results(m_checks.size());
+      for (auto const& group : m_groups)
+      {
+        group.run(results);
+      }
+      for (std::size_t i = 0; i < results.size(); ++i)
+      {
+        results[i].passed =
+            m_checks[i].min <= results[i].count && results[i].count <= m_checks[i].max;
+      }
+      return verification_report(std::move(results));
+    }
+  };
+} // namespace mockup
+
+#endif // MOCKUP_VERIFIER_HPP
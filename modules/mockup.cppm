@@ -0,0 +1,103 @@
+module;
+
+#include <mockup/fixture.hpp>
+#include <mockup/mockup.hpp>
+
+export module mockup;
+
+export namespace mockup
+{
+  using mockup::c_callback;
+  using mockup::call;
+  using mockup::checkpoint;
+  using mockup::checkpoint_t;
+  using mockup::either;
+  using mockup::expectation;
+  using mockup::expectation_error;
+  using mockup::expected_sequence;
+  using mockup::fixture_table;
+  using mockup::functions;
+  using mockup::golden_trace;
+  using mockup::interleaved;
+  using mockup::invocation_view;
+  using mockup::invoke;
+  using mockup::log_layout;
+  using mockup::matches;
+  using mockup::maybe;
+  using mockup::mock;
+  using mockup::mock_function;
+  using mockup::one_or_more;
+  using mockup::pattern;
+  using mockup::recording;
+  using mockup::sequence;
+  using mockup::serializer;
+  using mockup::then;
+  using mockup::trace;
+  using mockup::trace_log;
+  using mockup::trace_writer;
+  using mockup::tracked;
+  using mockup::tracked_histogram;
+  using mockup::trampoline;
+  using mockup::trampoline_context_last;
+  using mockup::verification_report;
+  using mockup::verification_result;
+  using mockup::verifier;
+  using mockup::zero_or_more;
+
+  using mockup::const_;
+  using mockup::non_const;
+  using mockup::overload;
+  using mockup::overload_t;
+
+  using mockup::equal_to;
+  using mockup::greater_than;
+  using mockup::greater_than_or_equal_to;
+  using mockup::less_than;
+  using mockup::less_than_or_equal_to;
+  using mockup::not_equal_to;
+  using mockup::predicate;
+  using mockup::predicate_t;
+
+  namespace capture
+  {
+    using mockup::capture::copy;
+    using mockup::capture::copy_t;
+    using mockup::capture::intern;
+    using mockup::capture::intern_t;
+    using mockup::capture::none;
+    using mockup::capture::none_t;
+    using mockup::capture::project;
+    using mockup::capture::projection_t;
+    using mockup::capture::view;
+    using mockup::capture::view_t;
+  } // namespace capture
+
+  namespace helpers
+  {
+    using mockup::helpers::operator==;
+    using mockup::helpers::operator!=;
+    using mockup::helpers::_;
+    using mockup::helpers::from_table;
+    using mockup::helpers::ref;
+    using mockup::helpers::reference;
+    using mockup::helpers::replay;
+    using mockup::helpers::return_;
+    using mockup::helpers::spy;
+    using mockup::helpers::throw_;
+    using mockup::helpers::wildcard;
+    using mockup::helpers::wildcard_t;
+  } // namespace helpers
+
+  // Using-directives cannot be exported, so the helpers are also redeclared
+  // directly in mockup to keep `using namespace mockup;` working for importers.
+  using mockup::helpers::_;
+  using mockup::helpers::from_table;
+  using mockup::helpers::ref;
+  using mockup::helpers::reference;
+  using mockup::helpers::replay;
+  using mockup::helpers::return_;
+  using mockup::helpers::spy;
+  using mockup::helpers::throw_;
+  using mockup::helpers::wildcard;
+  using mockup::helpers::wildcard_t;
+} // namespace mockup
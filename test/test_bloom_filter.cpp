@@ -0,0 +1,199 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct cache
+  {
+    virtual void store(int key, std::string const& value) = 0;
+    virtual void evict(int key) = 0;
+  };
+
+  struct test_cache : cache
+  {
+    void store(int key, std::string const& value) override
+    {
+      invoke<&cache::store>(*this, key, value);
+    }
+
+    void evict(int key) override
+    {
+      invoke<&cache::evict>(*this, key);
+    }
+  };
+} // namespace
+
+SCENARIO("Bloom filters answer negative checks without scanning the log")
+{
+  GIVEN("a filter with some hashes inserted")
+  {
+    detail::bloom_filter filter(1 << 16);
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      filter.insert(i);
+    }
+
+    THEN("every inserted hash might be contained")
+    {
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+        REQUIRE(filter.might_contain(i));
+      }
+    }
+
+    THEN("few other hashes might be contained")
+    {
+      std::size_t false_positives = 0;
+      for (std::size_t i = 1000; i < 11000; ++i)
+      {
+        false_positives += filter.might_contain(i) ? 1 : 0;
+      }
+      CHECK(false_positives < 10);
+    }
+
+    THEN("clearing the filter removes every hash")
+    {
+      filter.clear();
+      CHECK(!filter.might_contain(0));
+      CHECK(filter.bits() == 1 << 16);
+    }
+  }
+
+  GIVEN("a mocked class with a filter on every member function")
+  {
+    mock<test_cache> c;
+    c.bloom_filter(1 << 14);
+
+    WHEN("calls are made")
+    {
+      for (int i = 0; i < 1000; i += 2)
+      {
+        c->store(i, std::to_string(i));
+        c->evict(i);
+      }
+
+      THEN("checks for values that were passed still succeed")
+      {
+        for (int i = 0; i < 1000; i += 2)
+        {
+          REQUIRE(c.invoked<&cache::store>(i, std::to_string(i)));
+          REQUIRE(c.times<&cache::evict>(i) == 1);
+        }
+      }
+
+      THEN("checks for values that were never passed fail")
+      {
+        for (int i = 1; i < 1000; i += 2)
+        {
+          REQUIRE(!c.invoked<&cache::store>(i, std::to_string(i)));
+          REQUIRE(c.times<&cache::evict>(i) == 0);
+        }
+        CHECK(!c.invoked<&cache::store>(2, std::string("3")));
+      }
+
+      THEN("checks with other matchers scan the log")
+      {
+        CHECK(c.invoked<&cache::store>(_, std::string("998")));
+        CHECK(c.times<&cache::evict>(greater_than(900)) == 49);
+        CHECK(!c.invoked<&cache::store>(1, _));
+      }
+
+      THEN("checks of a slice of the log are answered the same way")
+      {
+        sequence seq;
+        CHECK(c.invoked<&cache::evict>(seq, 500));
+        CHECK(!c.invoked<&cache::evict>(seq, 400));
+        CHECK(!c.invoked<&cache::evict>(seq, 501));
+        CHECK(c.invoked<&cache::evict>(seq, 502));
+      }
+    }
+  }
+
+  GIVEN("a mocked class with calls recorded before a filter is chosen")
+  {
+    mock<test_cache> c;
+    c->evict(1);
+    c->evict(2);
+
+    WHEN("a filter is chosen for one member function")
+    {
+      c.bloom_filter<&cache::evict>(256);
+      c->evict(3);
+
+      THEN("the calls recorded before are found")
+      {
+        CHECK(c.invoked<&cache::evict>(1));
+        CHECK(c.invoked<&cache::evict>(2));
+        CHECK(c.invoked<&cache::evict>(3));
+        CHECK(!c.invoked<&cache::evict>(4));
+      }
+
+      AND_WHEN("the filter is disabled")
+      {
+        c.bloom_filter<&cache::evict>(0);
+        c->evict(4);
+
+        THEN("checks scan the log")
+        {
+          CHECK(c.invoked<&cache::evict>(4));
+          CHECK(!c.invoked<&cache::evict>(5));
+        }
+      }
+    }
+  }
+
+  GIVEN("a mocked class with a filter and an argument captured by projection")
+  {
+    mock<test_cache> c;
+    c.bloom_filter(1 << 10);
+    c.capture<&cache::store, 1>(capture::project([](std::string const& value) {
+      return value.size();
+    }));
+    c->store(1, "xyz");
+
+    THEN("values with the same projection are found")
+    {
+      CHECK(c.invoked<&cache::store>(1, std::string("abc")));
+      CHECK(!c.invoked<&cache::store>(1, std::string("abcd")));
+      CHECK(c.times<&cache::store>(1, std::string("abc")) == 1);
+    }
+
+    WHEN("the argument is copied again and the calls are cleared")
+    {
+      c.capture<&cache::store, 1>(capture::copy);
+      c.clear<&cache::store>();
+      c->store(2, "xyz");
+
+      THEN("checks are answered by value again")
+      {
+        CHECK(c.invoked<&cache::store>(2, std::string("xyz")));
+        CHECK(!c.invoked<&cache::store>(2, std::string("abc")));
+      }
+    }
+  }
+
+  GIVEN("a mock function with a filter")
+  {
+    mock_function<void(std::string const&)> f;
+    f.bloom_filter(1024);
+
+    WHEN("it is called")
+    {
+      f("alpha");
+      f("beta");
+
+      THEN("negative checks fail and positive checks succeed")
+      {
+        CHECK(f.invoked(std::string("alpha")));
+        CHECK(!f.invoked(std::string("gamma")));
+        CHECK(f.times(std::string("beta")) == 1);
+      }
+    }
+  }
+}
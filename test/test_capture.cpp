@@ -0,0 +1,235 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mockup;
+
+namespace
+{
+  std::size_t allocations = 0;
+} // namespace
+
+// Counts the allocations of the whole test program, so that tests can check that an
+// operation makes none.
+void* operator new(std::size_t size)
+{
+  ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+  struct sink
+  {
+    virtual void write(std::string const& payload, int channel) = 0;
+    virtual void send(std::vector<char> const& buffer) = 0;
+  };
+
+  struct test_sink : sink
+  {
+    void write(std::string const& payload, int channel) override
+    {
+      invoke<&sink::write>(*this, payload, channel);
+    }
+
+    void send(std::vector<char> const& buffer) override
+    {
+      invoke<&sink::send>(*this, buffer);
+    }
+  };
+
+  std::size_t hash_of(std::string const& s)
+  {
+    return std::hash<std::string>()(s);
+  }
+} // namespace
+
+SCENARIO("arguments can be captured by copy, view, projection or not at all")
+{
+  GIVEN("a mocked class capturing an argument by view")
+  {
+    mock<test_sink> s;
+    s.capture<&sink::write, 0>(capture::view);
+    std::string payload = "first";
+
+    WHEN("a call is made and the argument then changes")
+    {
+      s->write(payload, 1);
+      payload = "second";
+
+      THEN("the log refers to the argument itself")
+      {
+        CHECK(s.invoked<&sink::write>(std::string("second"), 1));
+        CHECK(!s.invoked<&sink::write>(std::string("first"), 1));
+        CHECK(&s.invocations<&sink::write>().first().get<0>() == &payload);
+      }
+    }
+  }
+
+  GIVEN("a mocked class capturing an argument by projection")
+  {
+    mock<test_sink> s;
+    s.capture<&sink::write, 0>(capture::project(hash_of));
+    s.capture<&sink::send, 0>(capture::project([](std::vector<char> const& buffer) {
+      return buffer.size();
+    }));
+
+    WHEN("calls are made")
+    {
+      s->write(std::string(1 << 20, 'x'), 1);
+      s->write("short", 2);
+      s->send(std::vector<char>(4096));
+
+      THEN("values of the argument type are matched by their projection")
+      {
+        CHECK(s.invoked<&sink::write>(std::string(1 << 20, 'x'), 1));
+        CHECK(!s.invoked<&sink::write>(std::string(1 << 20, 'y'), 1));
+        CHECK(s.invoked<&sink::write>(equal_to(std::string("short")), _));
+        CHECK(s.times<&sink::write>(not_equal_to(std::string("short")), _) == 1);
+        CHECK(s.times<&sink::write>(_, greater_than(0)) == 2);
+        CHECK(s.invoked<&sink::send>(std::vector<char>(4096, 'z')));
+      }
+
+      THEN("other matchers and reads of the argument throw")
+      {
+        CHECK_THROWS_AS(
+            s.invoked<&sink::write>(less_than(std::string("a")), _), std::logic_error);
+        CHECK_THROWS_AS(s.invocations<&sink::write>().first().get<0>(), std::logic_error);
+        CHECK(s.invocations<&sink::write>().last().get<1>() == 2);
+      }
+
+      THEN("verifiers and patterns match by projection")
+      {
+        verifier v;
+        auto shorts = v.times<&sink::write>(s, 1, std::string("short"), 2);
+        v.never<&sink::write>(s, std::string("long"), _);
+        auto report = v.verify();
+        CHECK(report.passed());
+        CHECK(report[shorts].count == 1);
+
+        CHECK(matches(then(
+            call<&sink::write>(s, std::string(1 << 20, 'x'), _),
+            call<&sink::write>(s, std::string("short"), _))));
+      }
+
+      THEN("the column layout keeps the projections")
+      {
+        s.layout<&sink::write>(log_layout::columns);
+        CHECK(s.invoked<&sink::write>(std::string("short"), 2));
+        s.layout<&sink::write>(log_layout::rows);
+        CHECK(s.invoked<&sink::write>(std::string("short"), 2));
+      }
+
+      THEN("a Bloom filter chosen afterwards does not give false negatives")
+      {
+        s.bloom_filter<&sink::write>(1024);
+        s->write("third", 3);
+        CHECK(s.invoked<&sink::write>(std::string("short"), 2));
+        CHECK(s.invoked<&sink::write>(std::string("third"), 3));
+        CHECK(!s.invoked<&sink::write>(std::string("fourth"), 4));
+      }
+    }
+  }
+
+  GIVEN("a mocked class that does not capture an argument")
+  {
+    mock<test_sink> s;
+    s.capture<&sink::send, 0>(capture::none);
+
+    WHEN("calls are made")
+    {
+      s->send(std::vector<char>(10));
+      s->send(std::vector<char>(20));
+
+      THEN("only wildcards match the argument")
+      {
+        CHECK(s.times<&sink::send>(_) == 2);
+        CHECK_THROWS_AS(s.invoked<&sink::send>(std::vector<char>(10)), std::logic_error);
+        CHECK_THROWS_AS(s.invocations<&sink::send>().first().get<0>(), std::logic_error);
+      }
+    }
+  }
+
+  GIVEN("a mocked class that changes the capture policy between calls")
+  {
+    mock<test_sink> s;
+    s->write("copied", 1);
+    s.capture<&sink::write, 0>(capture::none);
+    s->write("dropped", 2);
+    s.capture<&sink::write, 0>(capture::copy);
+    s->write("copied again", 3);
+
+    THEN("each call keeps the policy it was recorded with")
+    {
+      auto writes = s.invocations<&sink::write>();
+      CHECK(writes.nth(0).get<0>() == "copied");
+      CHECK_THROWS_AS(writes.nth(1).get<0>(), std::logic_error);
+      CHECK(writes.nth(2).get<0>() == "copied again");
+      CHECK(s.times<&sink::write>(_, _) == 3);
+    }
+  }
+
+  GIVEN("a mock function capturing an argument by projection")
+  {
+    mock_function<void(std::string const&)> f;
+    f.capture<0>(capture::project([](std::string const& s) {
+      return s.size();
+    }));
+
+    WHEN("it is called")
+    {
+      f("abc");
+
+      THEN("values with the same projection match")
+      {
+        CHECK(f.invoked(std::string("xyz")));
+        CHECK(!f.invoked(std::string("ab")));
+      }
+    }
+  }
+
+  GIVEN("a mock function taking arguments of class type")
+  {
+    auto const before = allocations;
+    mock_function<void(std::string, std::string)> f;
+    auto const after = allocations;
+
+    THEN("constructing it allocates nothing")
+    {
+      CHECK(after == before);
+    }
+
+    WHEN("it is called with the default policy")
+    {
+      f("a string too long for the small string buffer", "b");
+
+      THEN("the arguments are copied")
+      {
+        CHECK(f.invoked("a string too long for the small string buffer", "b"));
+        CHECK(f.invocations().first().get<1>() == "b");
+      }
+    }
+  }
+}
@@ -0,0 +1,157 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct socket
+  {
+    virtual int poll(int fd, int timeout) = 0;
+    virtual void read(int fd) = 0;
+    virtual void connect(std::string const& host) = 0;
+  };
+
+  struct test_socket : socket
+  {
+    int poll(int fd, int timeout) override
+    {
+      return invoke<&socket::poll>(*this, fd, timeout);
+    }
+
+    void read(int fd) override
+    {
+      invoke<&socket::read>(*this, fd);
+    }
+
+    void connect(std::string const& host) override
+    {
+      invoke<&socket::connect>(*this, host);
+    }
+  };
+} // namespace
+
+SCENARIO("runs of identical calls can be compressed")
+{
+  GIVEN("a mocked class compressing the calls to a member function")
+  {
+    mock<test_socket> s;
+    s.compress<&socket::poll>(true);
+    s.compress<&socket::connect>(true);
+
+    WHEN("a polling loop makes many identical calls")
+    {
+      s->poll(3, 100);
+      for (int i = 0; i < 100000; ++i)
+      {
+        s->poll(4, 100);
+      }
+      s->read(4);
+      s->poll(4, 100);
+      s->poll(4, 0);
+
+      THEN("every call is counted")
+      {
+        CHECK(s.times<&socket::poll>(_, _) == 100003);
+        CHECK(s.times<&socket::poll>(4, 100) == 100001);
+        CHECK(s.times<&socket::poll>(_, less_than(50)) == 1);
+        CHECK(s.invocations<&socket::poll>().count() == 100003);
+        CHECK(s.invocations<&socket::poll>().sum<1>() == 10000200);
+      }
+
+      THEN("calls keep their order")
+      {
+        auto polls = s.invocations<&socket::poll>();
+        CHECK(polls.nth(1).order() == polls.first().order() + 1);
+        CHECK(polls.nth(100000).order() == polls.first().order() + 100000);
+        CHECK(polls.nth(100001).order() == polls.first().order() + 100002);
+        CHECK(polls.nth(100001).get<0>() == 4);
+        CHECK(polls.last().get<1>() == 0);
+      }
+
+      THEN("sequences are checked exactly")
+      {
+        sequence seq;
+        CHECK(s.invoked<&socket::poll>(seq, 3, 100));
+        CHECK(s.invoked<&socket::poll>(seq, 4, 100));
+        CHECK(s.invoked<&socket::read>(seq, 4));
+        CHECK(s.invoked<&socket::poll>(seq, 4, 100));
+        CHECK(s.invoked<&socket::poll>(seq, 4, 0));
+        CHECK(!s.invoked<&socket::poll>(seq, 4, 100));
+      }
+    }
+
+    WHEN("a checkpoint is taken in the middle of a run")
+    {
+      for (int i = 0; i < 10; ++i)
+      {
+        s->poll(4, 100);
+      }
+      auto const cp = s.checkpoint();
+      for (int i = 0; i < 5; ++i)
+      {
+        s->poll(4, 100);
+      }
+
+      THEN("only the calls after it are counted")
+      {
+        CHECK(s.times<&socket::poll>(4, 100) == 15);
+        CHECK(s.times_since<&socket::poll>(cp, 4, 100) == 5);
+        CHECK(s.invoked_since<&socket::poll>(cp, 4, 100));
+      }
+    }
+
+    WHEN("identical arguments of class type are passed")
+    {
+      s->connect("example.com");
+      s->connect("example.com");
+      s->connect("example.org");
+
+      THEN("the run stores one copy")
+      {
+        auto connects = s.invocations<&socket::connect>();
+        CHECK(connects.count() == 3);
+        CHECK(&connects.nth(0).get<0>() == &connects.nth(1).get<0>());
+        CHECK(&connects.nth(1).get<0>() != &connects.nth(2).get<0>());
+        CHECK(s.times<&socket::connect>(std::string("example.com")) == 2);
+      }
+    }
+
+    WHEN("the log uses the column layout")
+    {
+      s.layout<&socket::poll>(log_layout::columns);
+      for (int i = 0; i < 100; ++i)
+      {
+        s->poll(4, i < 50 ? 100 : 0);
+      }
+
+      THEN("every call is counted")
+      {
+        CHECK(s.times<&socket::poll>(4, 100) == 50);
+        CHECK(s.times<&socket::poll>(_, less_than(50)) == 50);
+        CHECK(s.invocations<&socket::poll>().sum<1>() == 5000);
+      }
+    }
+  }
+
+  GIVEN("a mock function compressing its calls after some were recorded")
+  {
+    mock_function<void(int)> f;
+    f(1);
+    f(1);
+    f.compress(true);
+    f(1);
+    f(1);
+    f.compress(false);
+    f(1);
+
+    THEN("every call is counted")
+    {
+      CHECK(f.times(1) == 5);
+      CHECK(f.invocations().nth(4).order() == f.invocations().first().order() + 4);
+    }
+  }
+}
@@ -0,0 +1,363 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct connection
+  {
+    virtual void open(std::string const& host) = 0;
+    virtual int send(int bytes) = 0;
+    virtual void close() = 0;
+  };
+
+  struct test_connection : connection
+  {
+    void open(std::string const& host) override
+    {
+      invoke<&connection::open>(*this, host);
+    }
+
+    int send(int bytes) override
+    {
+      return invoke<&connection::send>(*this, bytes);
+    }
+
+    void close() override
+    {
+      invoke<&connection::close>(*this);
+    }
+  };
+} // namespace
+
+SCENARIO("ordered call sequences can be checked as the calls are made")
+{
+  GIVEN("a mocked class with an expected sequence")
+  {
+    mock<test_connection> conn;
+
+    expected_sequence seq;
+    conn.expect<&connection::open>(seq, "localhost");
+    conn.expect<&connection::send>(seq, 1);
+    conn.expect<&connection::send>(seq, greater_than(1));
+    conn.expect<&connection::close>(seq);
+
+    CHECK_FALSE(seq.satisfied());
+    CHECK(seq.remaining() == 4);
+
+    WHEN("the calls are made in order")
+    {
+      conn->open("localhost");
+      conn->send(1);
+      conn->send(1);
+      conn->send(2);
+      conn->close();
+
+      THEN("the sequence is satisfied")
+      {
+        CHECK(seq.satisfied());
+      }
+    }
+
+    WHEN("the calls are made out of order")
+    {
+      conn->send(1);
+      conn->open("localhost");
+      conn->send(2);
+      conn->close();
+
+      THEN("the sequence is not satisfied")
+      {
+        CHECK_FALSE(seq.satisfied());
+        CHECK(seq.remaining() == 3);
+      }
+    }
+
+    WHEN("one call matches two consecutive steps")
+    {
+      conn->open("localhost");
+      conn->send(2);
+      conn->close();
+
+      THEN("it only satisfies the first of them")
+      {
+        CHECK_FALSE(seq.satisfied());
+        CHECK(seq.remaining() == 3);
+      }
+    }
+
+    WHEN("recording is disabled")
+    {
+      conn.record<&connection::send>(false);
+
+      conn->open("localhost");
+      conn->send(1);
+      conn->send(5);
+      conn->close();
+
+      THEN("the sequence is still checked")
+      {
+        CHECK(seq.satisfied());
+        CHECK_FALSE(conn.invoked<&connection::send>(_));
+        CHECK(conn.invoked<&connection::close>());
+      }
+    }
+  }
+
+  GIVEN("a mocked function with an expected sequence")
+  {
+    mock_function<void(int)> f;
+
+    expected_sequence seq;
+    f.expect(seq, 1);
+    f.expect(seq, 2);
+    f.record(false);
+
+    WHEN("the calls are made in order")
+    {
+      f(2);
+      f(1);
+      f(3);
+      f(2);
+
+      THEN("the sequence is satisfied")
+      {
+        CHECK(seq.satisfied());
+        CHECK_FALSE(f.invoked(_));
+      }
+    }
+  }
+
+  GIVEN("a mocked function with several steps in an expected sequence")
+  {
+    mock_function<void(int)> f;
+    auto const& observers = detail::mock_function_access::instance(f).transient_observers;
+
+    expected_sequence seq;
+    f.expect(seq, 1);
+    f.expect(seq, 2);
+    f.expect(seq, 3);
+
+    THEN("the function has one observer")
+    {
+      CHECK(observers.size() == 1);
+    }
+
+    WHEN("the sequence is satisfied")
+    {
+      f(1);
+      f(2);
+      f(3);
+
+      THEN("the observer is dropped until more steps are added")
+      {
+        CHECK(seq.satisfied());
+        CHECK(observers.empty());
+
+        f.expect(seq, 4);
+        CHECK(observers.size() == 1);
+        f(4);
+        CHECK(seq.satisfied());
+        CHECK(observers.empty());
+      }
+    }
+
+    WHEN("the sequence is destroyed")
+    {
+      seq = expected_sequence();
+      f(1);
+
+      THEN("the observer is dropped at the next call")
+      {
+        CHECK(observers.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("call counts can be enforced as the calls are made")
+{
+  GIVEN("a mocked class with call count expectations")
+  {
+    mock<test_connection> conn;
+
+    auto opened = conn.expect<&connection::open>(_).times(1);
+    auto small = conn.expect<&connection::send>(less_than(10)).at_most(2);
+    auto large = conn.expect<&connection::send>(greater_than_or_equal_to(10)).at_least(1);
+    auto closed = conn.expect<&connection::close>().never();
+
+    WHEN("the calls stay within the expected counts")
+    {
+      conn->open("localhost");
+      conn->send(1);
+      conn->send(100);
+      conn->send(2);
+
+      THEN("the expectations are satisfied")
+      {
+        CHECK(opened.satisfied());
+        CHECK(small.satisfied());
+        CHECK(large.satisfied());
+        CHECK(closed.satisfied());
+        CHECK(small.count() == 2);
+      }
+    }
+
+    WHEN("a call exceeds an expected count")
+    {
+      conn->send(1);
+      conn->send(2);
+
+      THEN("the call throws and is not recorded")
+      {
+        CHECK_THROWS_AS(conn->send(3), expectation_error);
+        CHECK_FALSE(conn.invoked<&connection::send>(3));
+        CHECK_THROWS_AS(conn->close(), expectation_error);
+        CHECK(small.count() == 2);
+      }
+    }
+
+    WHEN("too few calls are made")
+    {
+      THEN("the expectations are not satisfied")
+      {
+        CHECK_FALSE(opened.satisfied());
+        CHECK_FALSE(large.satisfied());
+      }
+    }
+  }
+
+  GIVEN("a mocked function in a runaway loop")
+  {
+    mock_function<bool(int)> retry;
+    retry.record(false);
+    auto attempts = retry.expect(_).at_most(1000);
+
+    THEN("the loop fails at the first call over the limit")
+    {
+      int calls = 0;
+      CHECK_THROWS_AS(
+          [&] {
+            while (!retry(calls))
+            {
+              ++calls;
+            }
+          }(),
+          expectation_error);
+      CHECK(calls == 1000);
+      CHECK(attempts.count() == 1000);
+    }
+  }
+}
+
+namespace
+{
+  struct test_inline_connection
+  {
+    int send(int bytes)
+    {
+      return invoke<&test_inline_connection::send>(*this, bytes);
+    }
+
+    functions<&test_inline_connection::send> mockup_functions;
+  };
+} // namespace
+
+SCENARIO("strict mocks reject calls that have no registered action")
+{
+  GIVEN("a strict mocked class")
+  {
+    mock<test_connection> conn;
+    conn.strict();
+    conn.when<&connection::send>(greater_than(0))(return_(1));
+
+    WHEN("a call has a registered action")
+    {
+      THEN("the action is performed")
+      {
+        CHECK(conn->send(10) == 1);
+      }
+    }
+
+    WHEN("a call has no registered action")
+    {
+      THEN("the call throws")
+      {
+        CHECK_THROWS_AS(conn->send(0), expectation_error);
+        CHECK_THROWS_AS(conn->close(), expectation_error);
+        CHECK_THROWS_AS(conn->open("localhost"), expectation_error);
+      }
+    }
+
+    WHEN("a call without a registered action is rejected")
+    {
+      expected_sequence seq;
+      conn.expect<&connection::send>(seq, _);
+      auto sends = conn.expect<&connection::send>(_);
+      CHECK_THROWS_AS(conn->send(0), expectation_error);
+
+      THEN("the call is not observed or recorded")
+      {
+        CHECK(conn.times<&connection::send>(_) == 0);
+        CHECK(!conn.invoked<&connection::send>(0));
+        CHECK(sends.count() == 0);
+        CHECK(seq.remaining() == 1);
+      }
+    }
+
+    WHEN("one member function is made relaxed")
+    {
+      conn.strict<&connection::close>(false);
+
+      THEN("only that function accepts unexpected calls")
+      {
+        CHECK_NOTHROW(conn->close());
+        CHECK_THROWS_AS(conn->send(0), expectation_error);
+      }
+    }
+  }
+
+  GIVEN("a relaxed mocked class with one strict member function")
+  {
+    mock<test_connection> conn;
+    conn.strict<&connection::send>();
+
+    THEN("only that function rejects unexpected calls")
+    {
+      CHECK_NOTHROW(conn->close());
+      CHECK_THROWS_AS(conn->send(0), expectation_error);
+    }
+  }
+
+  GIVEN("a strict mock with inline member function state")
+  {
+    mock<test_inline_connection> conn;
+    conn.strict();
+
+    THEN("unexpected calls throw")
+    {
+      CHECK_THROWS_AS(conn->send(0), expectation_error);
+    }
+  }
+
+  GIVEN("a strict mocked function without recording")
+  {
+    mock_function<void(int)> f;
+    f.strict();
+    f.record(false);
+    f.when(less_than(1000))([](auto&&...) {});
+
+    THEN("expected calls are allowed and unexpected calls throw")
+    {
+      for (int i = 0; i < 1000; ++i)
+      {
+        f(i);
+      }
+      CHECK_THROWS_AS(f(1000), expectation_error);
+    }
+  }
+}
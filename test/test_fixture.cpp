@@ -0,0 +1,249 @@
+#include <mockup/fixture.hpp>
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct user
+  {
+    std::int32_t id;
+    std::int32_t age;
+    double score;
+  };
+
+  struct directory
+  {
+    virtual user lookup(std::int64_t id) = 0;
+    virtual int distance(int from, int to) = 0;
+  };
+
+  struct test_directory : directory
+  {
+    user lookup(std::int64_t id) override
+    {
+      return invoke<&directory::lookup>(*this, id);
+    }
+
+    int distance(int from, int to) override
+    {
+      return invoke<&directory::distance>(*this, from, to);
+    }
+  };
+
+  std::string fixture_path(char const* name)
+  {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+
+  template <typename Signature>
+  void save(fixture_table<Signature> const& table, std::string const& path)
+  {
+    std::ofstream out(path, std::ios::binary);
+    table.save(out);
+  }
+} // namespace
+
+SCENARIO("results can be served from a fixture table")
+{
+  GIVEN("a fixture table of many results, added out of order")
+  {
+    auto const path = fixture_path("mockup_test_users.bin");
+    {
+      fixture_table<user(std::int64_t)> users;
+      for (std::int64_t id = 99999; id >= 0; --id)
+      {
+        auto const i = static_cast<std::int32_t>(id);
+        users.add(id * 3, {i, 20 + i % 50, id * 0.5});
+      }
+      users.add(300, {-1, -1, -1.0});
+      CHECK(users.size() == 100001);
+      save(users, path);
+    }
+
+    WHEN("an action serves the table")
+    {
+      mock<test_directory> d;
+      d.when<&directory::lookup>(_)(from_table(path));
+
+      THEN("calls return the results for their arguments")
+      {
+        auto const u = d->lookup(3 * 1234);
+        CHECK(u.id == 1234);
+        CHECK(u.age == 20 + 1234 % 50);
+        CHECK(u.score == 617.0);
+        CHECK(d->lookup(0).id == 0);
+        CHECK(d->lookup(3 * 99999).id == 99999);
+      }
+
+      THEN("the last result added for the same arguments is served")
+      {
+        CHECK(d->lookup(300).id == -1);
+      }
+
+      THEN("arguments without a result throw")
+      {
+        CHECK_THROWS_AS(d->lookup(1), std::out_of_range);
+        CHECK_THROWS_AS(d->lookup(3 * 100000), std::out_of_range);
+      }
+
+      THEN("other actions take precedence as usual")
+      {
+        d.when<&directory::lookup>(7)(return_(user{7, 7, 7.0}));
+        CHECK(d->lookup(7).id == 7);
+        CHECK(d->lookup(6).id == 2);
+      }
+    }
+
+    WHEN("the table is served for a function with other argument types")
+    {
+      mock<test_directory> d;
+      d.when<&directory::distance>(_, _)(from_table(path));
+
+      THEN("calls throw")
+      {
+        CHECK_THROWS_AS(d->distance(0, 0), std::runtime_error);
+      }
+    }
+
+    std::filesystem::remove(path);
+  }
+
+  GIVEN("a fixture table keyed by several arguments")
+  {
+    auto const path = fixture_path("mockup_test_distances.bin");
+    {
+      fixture_table<int(int, int)> distances;
+      for (int from = -10; from <= 10; ++from)
+      {
+        for (int to = -10; to <= 10; ++to)
+        {
+          distances.add(from, to, to > from ? to - from : from - to);
+        }
+      }
+      save(distances, path);
+    }
+
+    THEN("results are found by all of the arguments")
+    {
+      mock_function<int(int, int)> f;
+      f.when(_, _)(from_table(path));
+      CHECK(f(-10, 10) == 20);
+      CHECK(f(3, -4) == 7);
+      CHECK(f(5, 5) == 0);
+      CHECK_THROWS_AS(f(11, 0), std::out_of_range);
+    }
+
+    std::filesystem::remove(path);
+  }
+
+  GIVEN("a fixture table keyed by floating-point arguments")
+  {
+    auto const path = fixture_path("mockup_test_rounding.bin");
+    {
+      fixture_table<int(double)> rounding;
+      rounding.add(0.0, 0);
+      rounding.add(1.5, 2);
+      rounding.add(std::numeric_limits<double>::quiet_NaN(), -1);
+      save(rounding, path);
+    }
+
+    THEN("equal values are found whatever their bits")
+    {
+      mock_function<int(double)> f;
+      f.when(_)(from_table(path));
+      CHECK(f(1.5) == 2);
+      CHECK(f(-0.0) == 0);
+      CHECK(f(-std::numeric_limits<double>::signaling_NaN()) == -1);
+      CHECK_THROWS_AS(f(2.5), std::out_of_range);
+    }
+
+    std::filesystem::remove(path);
+  }
+
+  GIVEN("argument types whose equal values may differ in their bytes")
+  {
+    THEN("they cannot be fixture keys")
+    {
+      CHECK(detail::is_fixture_key_v<std::int64_t>);
+      CHECK(detail::is_fixture_key_v<float>);
+      CHECK(detail::is_fixture_key_v<double>);
+      CHECK(!detail::is_fixture_key_v<long double>);
+      CHECK(!detail::is_fixture_key_v<user>);
+    }
+  }
+
+  GIVEN("a fixture table written for other types of the same sizes")
+  {
+    auto const path = fixture_path("mockup_test_scales.bin");
+    {
+      fixture_table<float(std::int32_t)> scales;
+      scales.add(1, 0.5f);
+      save(scales, path);
+    }
+
+    THEN("serving it for those types throws")
+    {
+      mock_function<int(std::uint32_t)> f;
+      f.when(_)(from_table(path));
+      CHECK_THROWS_AS(f(1), std::runtime_error);
+
+      mock_function<int(std::int32_t)> g;
+      g.when(_)(from_table(path));
+      CHECK_THROWS_AS(g(1), std::runtime_error);
+
+      mock_function<float(std::int32_t)> h;
+      h.when(_)(from_table(path));
+      CHECK(h(1) == 0.5f);
+    }
+
+    std::filesystem::remove(path);
+  }
+
+  GIVEN("a fixture table whose count of records overflows their size")
+  {
+    auto const path = fixture_path("mockup_test_overflow.bin");
+    {
+      std::ostringstream out;
+      fixture_table<int(int)> empty;
+      empty.save(out);
+      // Records of 8 bytes, of which 2^61 take 2^64 bytes, or none once wrapped.
+      auto bytes = out.str();
+      std::uint64_t const count = std::uint64_t(1) << 61;
+      std::memcpy(&bytes[20], &count, sizeof(count));
+      std::ofstream(path, std::ios::binary) << bytes;
+    }
+
+    THEN("serving it throws")
+    {
+      CHECK_THROWS_AS(from_table(path), std::runtime_error);
+    }
+
+    std::filesystem::remove(path);
+  }
+
+  GIVEN("a file that is not a fixture table")
+  {
+    auto const path = fixture_path("mockup_test_not_a_table.bin");
+    std::ofstream(path) << "not a fixture table";
+
+    THEN("serving it throws")
+    {
+      CHECK_THROWS_AS(from_table(path), std::runtime_error);
+      CHECK_THROWS_AS(from_table(fixture_path("mockup_test_missing.bin")), std::system_error);
+    }
+
+    std::filesystem::remove(path);
+  }
+}
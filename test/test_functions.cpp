@@ -0,0 +1,89 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace mockup;
+
+namespace
+{
+  // A component that takes its dependency as a template parameter.
+  template <typename Clock>
+  class throttle
+  {
+  private:
+    Clock& m_clock;
+    int m_interval;
+    int m_last = 0;
+
+  public:
+    throttle(Clock& clock, int interval)
+    : m_clock(clock)
+    , m_interval(interval)
+    {
+    }
+
+    bool ready()
+    {
+      auto now = m_clock.now();
+      if (now - m_last < m_interval)
+      {
+        return false;
+      }
+      m_last = now;
+      m_clock.sleep(m_interval);
+      return true;
+    }
+  };
+
+  struct test_clock
+  {
+    int now() const
+    {
+      return invoke<&test_clock::now>(*this);
+    }
+
+    void sleep(int ms)
+    {
+      invoke<&test_clock::sleep>(*this, ms);
+    }
+
+    functions<&test_clock::now, &test_clock::sleep> mockup_functions;
+  };
+} // namespace
+
+SCENARIO("mocks without a virtual interface store their state inline")
+{
+  GIVEN("a mock with inline member function state")
+  {
+    mock<test_clock> clock;
+    throttle<test_clock> t(*clock, 10);
+
+    WHEN("the component under test calls the mock")
+    {
+      clock.when<&test_clock::now>()(return_(5, 20, 25, 31));
+
+      CHECK_FALSE(t.ready());
+      CHECK(t.ready());
+      CHECK_FALSE(t.ready());
+      CHECK(t.ready());
+
+      THEN("the invocations are recorded in the inline state")
+      {
+        CHECK(clock.invoked<&test_clock::now>());
+        CHECK(clock.invoked<&test_clock::sleep>(10));
+        CHECK_FALSE(clock.invoked<&test_clock::sleep>(greater_than(10)));
+        CHECK(clock->mockup_functions.get<&test_clock::sleep>().invocations.size() == 2);
+      }
+
+      THEN("the invocations can be checked in sequence")
+      {
+        sequence seq;
+        CHECK(clock.invoked<&test_clock::now>(seq));
+        CHECK(clock.invoked<&test_clock::sleep>(seq, 10));
+        CHECK(clock.invoked<&test_clock::now>(seq));
+        CHECK(clock.invoked<&test_clock::sleep>(seq, 10));
+        CHECK_FALSE(clock.invoked<&test_clock::sleep>(seq, _));
+      }
+    }
+  }
+}
@@ -0,0 +1,160 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct channel
+  {
+    virtual void send(int id, std::string const& data) = 0;
+    virtual void ack(int id) = 0;
+  };
+
+  struct test_channel : channel
+  {
+    void send(int id, std::string const& data) override
+    {
+      invoke<&channel::send>(*this, id, data);
+    }
+
+    void ack(int id) override
+    {
+      invoke<&channel::ack>(*this, id);
+    }
+  };
+
+  // Makes `calls` exchanges, the one numbered `changed` with other data.
+  void exchange(channel& c, int calls, int changed = -1)
+  {
+    for (int i = 0; i < calls; ++i)
+    {
+      c.send(i, i == changed ? "changed" : "data");
+      c.ack(i);
+    }
+  }
+} // namespace
+
+SCENARIO("calls can be compared with a golden trace as they are made")
+{
+  GIVEN("a golden trace written as the calls were made")
+  {
+    std::stringstream golden;
+    {
+      mock<test_channel> c;
+      c.record<&channel::send>(false);
+      c.record<&channel::ack>(false);
+      trace_writer writer(golden);
+      writer.follow<&channel::send>("send", c);
+      writer.follow<&channel::ack>("ack", c);
+      exchange(*c, 1000);
+      CHECK(c.invocations<&channel::send>().empty());
+    }
+
+    WHEN("the same calls are made")
+    {
+      mock<test_channel> c;
+      golden_trace expected(golden);
+      expected.follow<&channel::send>("send", c);
+      expected.follow<&channel::ack>("ack", c);
+      exchange(*c, 1000);
+
+      THEN("they match")
+      {
+        CHECK(expected.finish());
+        CHECK(!expected.diverged());
+        CHECK(expected.matched() == 2000);
+        CHECK(expected.report().empty());
+      }
+    }
+
+    WHEN("a call differs")
+    {
+      mock<test_channel> c;
+      golden_trace expected(golden, 2);
+      expected.follow<&channel::send>("send", c);
+      expected.follow<&channel::ack>("ack", c);
+
+      THEN("the call throws with the calls around it")
+      {
+        exchange(*c, 500);
+        CHECK_THROWS_AS(c->send(500, "changed"), expectation_error);
+        CHECK(expected.diverged());
+        CHECK(expected.matched() == 1000);
+
+        auto const report = expected.report();
+        CHECK(report.find("call 1001 diverges") != std::string::npos);
+        CHECK(report.find("after:\n    send(") != std::string::npos);
+        CHECK(report.find("golden trace continues with:\n    ack(") != std::string::npos);
+
+        AND_THEN("later calls are not compared")
+        {
+          CHECK_NOTHROW(c->ack(500));
+          CHECK(!expected.finish());
+        }
+      }
+    }
+
+    WHEN("calls are missing")
+    {
+      mock<test_channel> c;
+      golden_trace expected(golden);
+      expected.follow<&channel::send>("send", c);
+      expected.follow<&channel::ack>("ack", c);
+      exchange(*c, 999);
+
+      THEN("finishing reports the first missing call")
+      {
+        CHECK(!expected.finish());
+        CHECK(expected.report().find("actual:   no more calls") != std::string::npos);
+      }
+    }
+
+    WHEN("there are more calls than in the golden trace")
+    {
+      mock_function<void(int)> f;
+      golden_trace expected(golden);
+      expected.follow("ack", f);
+
+      THEN("the first call of another function throws")
+      {
+        CHECK_THROWS_AS(f(0), expectation_error);
+        CHECK(expected.report().find("expected: send(") != std::string::npos);
+      }
+    }
+  }
+
+  GIVEN("two traces written from calls")
+  {
+    auto write = [](std::stringstream& stream, int changed) {
+      mock<test_channel> c;
+      trace_writer writer(stream);
+      writer.follow<&channel::send>("send", c);
+      writer.follow<&channel::ack>("ack", c);
+      exchange(*c, 100, changed);
+    };
+    std::stringstream golden;
+    std::stringstream actual;
+    write(golden, -1);
+
+    THEN("equal traces are compared record by record")
+    {
+      write(actual, -1);
+      golden_trace expected(golden);
+      CHECK(expected.compare(actual));
+      CHECK(expected.matched() == 200);
+    }
+
+    THEN("the first difference is reported")
+    {
+      write(actual, 10);
+      golden_trace expected(golden);
+      CHECK(!expected.compare(actual));
+      CHECK(expected.matched() == 20);
+    }
+  }
+}
@@ -0,0 +1,113 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct metrics
+  {
+    virtual void increment(std::string const& name, int amount) = 0;
+    virtual void gauge(std::string const& name, double value) = 0;
+  };
+
+  struct test_metrics : metrics
+  {
+    void increment(std::string const& name, int amount) override
+    {
+      invoke<&metrics::increment>(*this, name, amount);
+    }
+
+    void gauge(std::string const& name, double value) override
+    {
+      invoke<&metrics::gauge>(*this, name, value);
+    }
+  };
+} // namespace
+
+SCENARIO("arguments can be interned")
+{
+  GIVEN("a mocked class interning the arguments of two member functions")
+  {
+    mock<test_metrics> m;
+    m.capture<&metrics::increment, 0>(capture::intern);
+    m.capture<&metrics::gauge, 0>(capture::intern);
+
+    WHEN("calls are made with repeated values")
+    {
+      for (int i = 0; i < 1000; ++i)
+      {
+        m->increment(i % 2 == 0 ? "requests" : "errors", i);
+      }
+      m->gauge("requests", 0.5);
+
+      THEN("each distinct value is stored once per mock")
+      {
+        auto increments = m.invocations<&metrics::increment>();
+        auto const* requests = &increments.nth(0).get<0>();
+        CHECK(*requests == "requests");
+        CHECK(&increments.nth(2).get<0>() == requests);
+        CHECK(&increments.nth(998).get<0>() == requests);
+        CHECK(&increments.nth(1).get<0>() != requests);
+        CHECK(&m.invocations<&metrics::gauge>().first().get<0>() == requests);
+      }
+
+      THEN("interned values are matched")
+      {
+        CHECK(m.invoked<&metrics::increment>(std::string("requests"), 998));
+        CHECK(!m.invoked<&metrics::increment>(std::string("requests"), 999));
+        CHECK(m.times<&metrics::increment>(std::string("errors"), _) == 500);
+        CHECK(m.times<&metrics::increment>(std::string("latency"), _) == 0);
+        CHECK(m.times<&metrics::increment>(not_equal_to(std::string("errors")), _) == 500);
+        CHECK(m.invoked<&metrics::gauge>(std::string("requests"), 0.5));
+      }
+    }
+
+    WHEN("the log uses the column layout")
+    {
+      m.layout<&metrics::increment>(log_layout::columns);
+      m->increment("requests", 1);
+      m->increment("errors", 2);
+
+      THEN("interned values are matched")
+      {
+        CHECK(m.invoked<&metrics::increment>(std::string("errors"), 2));
+        CHECK(!m.invoked<&metrics::increment>(std::string("errors"), 1));
+      }
+    }
+  }
+
+  GIVEN("a mocked class that starts interning after some calls")
+  {
+    mock<test_metrics> m;
+    m->increment("requests", 1);
+    m.capture<&metrics::increment, 0>(capture::intern);
+    m->increment("requests", 2);
+    m->increment("errors", 3);
+
+    THEN("arguments recorded before and after are both matched")
+    {
+      CHECK(m.times<&metrics::increment>(std::string("requests"), _) == 2);
+      CHECK(m.invoked<&metrics::increment>(std::string("requests"), 1));
+      CHECK(m.invoked<&metrics::increment>(std::string("errors"), 3));
+      CHECK(!m.invoked<&metrics::increment>(std::string("latency"), _));
+    }
+  }
+
+  GIVEN("a mock function interning an argument")
+  {
+    mock_function<void(std::string const&)> f;
+    f.capture<0>(capture::intern);
+    f("requests");
+    f("requests");
+
+    THEN("each distinct value is stored once")
+    {
+      CHECK(f.times(std::string("requests")) == 2);
+      CHECK(&f.invocations().nth(0).get<0>() == &f.invocations().nth(1).get<0>());
+    }
+  }
+}
@@ -0,0 +1,153 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mockup;
+
+namespace
+{
+  struct channel
+  {
+    virtual void send(int id, std::string const& payload) = 0;
+    virtual void flush() = 0;
+  };
+
+  struct test_channel : channel
+  {
+    void send(int id, std::string const& payload) override
+    {
+      invoke<&channel::send>(*this, id, payload);
+    }
+
+    void flush() override
+    {
+      invoke<&channel::flush>(*this);
+    }
+  };
+} // namespace
+
+SCENARIO("recorded invocations can be read through lazy views")
+{
+  GIVEN("a mocked class with recorded invocations")
+  {
+    mock<test_channel> ch;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+      ch->send(i, "payload " + std::to_string(i));
+    }
+    ch->flush();
+
+    WHEN("the invocations are viewed")
+    {
+      auto sends = ch.invocations<&channel::send>();
+
+      THEN("the arguments can be read without copying")
+      {
+        CHECK(sends.count() == 10000);
+        CHECK(sends.nth(9999).get<1>() == "payload 9999");
+        CHECK(sends.last().get<0>() == 9999);
+        CHECK(sends.first().order() < sends.last().order());
+        CHECK(&sends.nth(5).get<1>() == &sends.nth(5).get<1>());
+
+        auto [id, payload] = sends.nth(42).arguments();
+        CHECK(id == 42);
+        CHECK(payload == "payload 42");
+
+        CHECK(ch.invocations<&channel::flush>().last().order() > sends.last().order());
+      }
+
+      THEN("the view can be filtered with matchers")
+      {
+        auto large = sends.where(greater_than_or_equal_to(9990), _);
+        CHECK(large.count() == 10);
+        CHECK(large.nth(0).get<0>() == 9990);
+        CHECK(large.last().get<0>() == 9999);
+
+        auto one = large.where(_, "payload 9995");
+        CHECK(one.count() == 1);
+        CHECK(one.first().get<0>() == 9995);
+
+        std::vector<int> ids;
+        for (auto call : large.where(less_than(9993), _))
+        {
+          ids.push_back(call.get<0>());
+        }
+        CHECK(ids == std::vector<int>{9990, 9991, 9992});
+      }
+
+      THEN("missing elements are reported")
+      {
+        CHECK(sends.where(-1, _).empty());
+        CHECK_THROWS_AS(sends.where(-1, _).last(), std::out_of_range);
+        CHECK_THROWS_AS(sends.nth(10000), std::out_of_range);
+      }
+    }
+  }
+
+  GIVEN("a mocked function with recorded invocations")
+  {
+    mock_function<void(int)> f;
+    f(3);
+    f(4);
+
+    THEN("its invocations can be viewed")
+    {
+      CHECK(f.invocations().count() == 2);
+      CHECK(f.invocations().where(4).first().get<0>() == 4);
+    }
+  }
+}
+
+SCENARIO("recorded invocations can be cleared")
+{
+  GIVEN("a mocked class with recorded invocations and an action")
+  {
+    mock<test_channel> ch;
+    ch.bloom_filter(1 << 10);
+    ch.capture<&channel::send, 1>(capture::none);
+    ch->send(1, "first");
+    ch->flush();
+    ch.capture<&channel::send, 1>(capture::copy);
+
+    WHEN("the invocations of one member function are cleared")
+    {
+      ch.clear<&channel::send>();
+
+      THEN("only they are forgotten")
+      {
+        CHECK(ch.invocations<&channel::send>().empty());
+        CHECK(!ch.invoked<&channel::send>(1, _));
+        CHECK(ch.invocations<&channel::flush>().count() == 1);
+      }
+
+      THEN("later calls are recorded and found as before")
+      {
+        ch->send(2, "second");
+        CHECK(ch.invoked<&channel::send>(2, std::string("second")));
+        CHECK(!ch.invoked<&channel::send>(1, std::string("first")));
+        CHECK(ch.times<&channel::send>(_, _) == 1);
+      }
+    }
+  }
+
+  GIVEN("a mocked function with recorded invocations")
+  {
+    mock_function<int(int)> f;
+    f.when(_)(return_(7));
+    f(3);
+    f.clear();
+
+    THEN("its invocations are forgotten and its actions kept")
+    {
+      CHECK(f.invocations().empty());
+      CHECK(f(4) == 7);
+      CHECK(f.invoked(4));
+      CHECK(!f.invoked(3));
+    }
+  }
+}
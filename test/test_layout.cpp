@@ -0,0 +1,142 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct sensor
+  {
+    virtual void sample(int channel, double value, bool valid) = 0;
+    virtual void label(std::string const& name) = 0;
+  };
+
+  struct test_sensor : sensor
+  {
+    void sample(int channel, double value, bool valid) override
+    {
+      invoke<&sensor::sample>(*this, channel, value, valid);
+    }
+
+    void label(std::string const& name) override
+    {
+      invoke<&sensor::label>(*this, name);
+    }
+  };
+} // namespace
+
+SCENARIO("invocation logs can store arguments in columns")
+{
+  GIVEN("a mocked class using the column layout")
+  {
+    mock<test_sensor> s;
+    s.layout<&sensor::sample>(log_layout::columns);
+    s.layout<&sensor::label>(log_layout::columns);
+
+    WHEN("calls are made")
+    {
+      for (int i = 0; i < 1000; ++i)
+      {
+        s->sample(i % 16, i * 0.5, i % 2 == 0);
+      }
+      s->label("first");
+      auto mark = s.checkpoint();
+      s->label("second");
+
+      THEN("checks see the recorded arguments")
+      {
+        CHECK(s.invoked<&sensor::sample>(15, 7.5, false));
+        CHECK(!s.invoked<&sensor::sample>(15, 7.5, true));
+        CHECK(s.times<&sensor::sample>(3, _, _) == 63);
+        CHECK(s.times<&sensor::sample>(_, _, true) == 500);
+        CHECK(s.times<&sensor::sample>(less_than(4), greater_than(400.0), _) == 51);
+        CHECK(s.invoked<&sensor::label>(std::string("first")));
+        CHECK(s.times_since<&sensor::label>(mark, _) == 1);
+        CHECK(!s.invoked_since<&sensor::label>(mark, std::string("first")));
+      }
+
+      THEN("views read the columns")
+      {
+        auto samples = s.invocations<&sensor::sample>();
+        CHECK(samples.count() == 1000);
+        CHECK(samples.nth(17).get<0>() == 1);
+        CHECK(samples.nth(17).get<1>() == 8.5);
+        CHECK(samples.nth(17).get<2>() == false);
+        CHECK(samples.where(_, _, true).count() == 500);
+        CHECK(s.invocations<&sensor::label>().last().get<0>() == "second");
+      }
+
+      THEN("patterns and verifiers see the recorded arguments")
+      {
+        CHECK(matches(then(
+            one_or_more(call<&sensor::sample>(s, _, _, _)),
+            call<&sensor::label>(s, std::string("first")),
+            call<&sensor::label>(s, std::string("second")))));
+
+        verifier v;
+        auto twos = v.times<&sensor::sample>(s, 63, 2, _, _);
+        v.never<&sensor::sample>(s, 16, _, _);
+        auto report = v.verify();
+        CHECK(report.passed());
+        CHECK(report[twos].count == 63);
+      }
+
+      AND_WHEN("the layout is changed back to rows")
+      {
+        s.layout<&sensor::sample>(log_layout::rows);
+        s->sample(99, 1.0, true);
+
+        THEN("the calls recorded so far are kept")
+        {
+          CHECK(s.times<&sensor::sample>(_, _, _) == 1001);
+          CHECK(s.invoked<&sensor::sample>(15, 7.5, false));
+          CHECK(s.invocations<&sensor::sample>().last().get<0>() == 99);
+        }
+      }
+    }
+  }
+
+  GIVEN("a mocked class with calls recorded in rows")
+  {
+    mock<test_sensor> s;
+    s->sample(1, 2.0, true);
+    s->sample(3, 4.0, false);
+
+    WHEN("the layout is changed to columns")
+    {
+      s.layout<&sensor::sample>(log_layout::columns);
+      s->sample(5, 6.0, true);
+
+      THEN("the calls recorded so far are kept")
+      {
+        CHECK(s.invoked<&sensor::sample>(1, 2.0, true));
+        CHECK(s.invoked<&sensor::sample>(3, 4.0, false));
+        CHECK(s.invoked<&sensor::sample>(5, 6.0, true));
+        CHECK(s.times<&sensor::sample>(_, _, _) == 3);
+      }
+    }
+  }
+
+  GIVEN("a mock function using the column layout")
+  {
+    mock_function<int(int, std::string const&)> f;
+    f.layout(log_layout::columns);
+    f.when(_, _, return_(1));
+
+    WHEN("it is called")
+    {
+      f(1, "one");
+      f(2, "two");
+
+      THEN("checks see the recorded arguments")
+      {
+        CHECK(f.invoked(2, std::string("two")));
+        CHECK(f.times(_, _) == 2);
+        CHECK(f.invocations().first().get<1>() == "one");
+      }
+    }
+  }
+}
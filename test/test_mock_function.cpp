@@ -0,0 +1,183 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace mockup;
+
+namespace
+{
+  class button
+  {
+  private:
+    std::function<bool(std::string const&, int)> m_on_click;
+
+  public:
+    explicit button(std::function<bool(std::string const&, int)> on_click)
+    : m_on_click(std::move(on_click))
+    {
+    }
+
+    bool click(int count)
+    {
+      return m_on_click("button", count);
+    }
+  };
+} // namespace
+
+SCENARIO("standalone functions can be mocked")
+{
+  GIVEN("a mocked function")
+  {
+    mock_function<bool(std::string const&, int)> on_click;
+
+    WHEN("it is injected as a callback")
+    {
+      on_click.when(_, greater_than(1))(return_(true));
+
+      button b(std::ref(on_click));
+
+      CHECK_FALSE(b.click(1));
+      CHECK(b.click(2));
+      CHECK(b.click(3));
+
+      THEN("the invocations can be checked")
+      {
+        CHECK(on_click.invoked("button", 1));
+        CHECK(on_click.invoked(_, 3));
+        CHECK_FALSE(on_click.invoked("label", _));
+        CHECK_FALSE(on_click.invoked(_, less_than(1)));
+      }
+
+      THEN("the invocations can be checked in sequence")
+      {
+        sequence seq;
+        CHECK(on_click.invoked(seq, _, 2));
+        CHECK_FALSE(on_click.invoked(seq, _, 1));
+        CHECK(on_click.invoked(seq, _, 3));
+      }
+    }
+
+    WHEN("an action throws an exception")
+    {
+      on_click.when(_, 0)(throw_(std::runtime_error("no clicks")));
+
+      THEN("the invocation throws")
+      {
+        CHECK_THROWS(on_click("button", 0));
+        CHECK_FALSE(on_click("button", 1));
+      }
+    }
+  }
+
+  GIVEN("many mocked functions")
+  {
+    std::vector<mock_function<int(int)>> functions(1000);
+
+    WHEN("each is invoked")
+    {
+      for (std::size_t i = 0; i < functions.size(); ++i)
+      {
+        functions[i].when(_)(return_(static_cast<int>(i)));
+        CHECK(functions[i](0) == static_cast<int>(i));
+      }
+
+      THEN("each records its own invocations")
+      {
+        sequence seq;
+        for (auto& f : functions)
+        {
+          CHECK(f.invoked(seq, 0));
+        }
+      }
+    }
+  }
+}
+
+namespace
+{
+  extern "C" typedef void (*packet_handler)(void* context, int length);
+  extern "C" typedef int (*compare_function)(int a, int b, void* context);
+
+  void deliver(packet_handler handler, void* context, int count)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      handler(context, i);
+    }
+  }
+
+  int compare(compare_function function, void* context, int a, int b)
+  {
+    return function(a, b, context);
+  }
+} // namespace
+
+SCENARIO("mocked functions can be called through C callbacks")
+{
+  GIVEN("a mocked function")
+  {
+    mock_function<void(int)> on_packet;
+
+    WHEN("it is called through a trampoline with a leading context")
+    {
+      auto callback = trampoline(on_packet);
+      deliver(callback.function, callback.context, 3);
+
+      THEN("the invocations are recorded")
+      {
+        sequence seq;
+        CHECK(on_packet.invoked(seq, 0));
+        CHECK(on_packet.invoked(seq, 1));
+        CHECK(on_packet.invoked(seq, 2));
+        CHECK_FALSE(on_packet.invoked(seq, _));
+      }
+    }
+  }
+
+  GIVEN("a mocked function with a return value")
+  {
+    mock_function<int(int, int)> on_compare;
+    on_compare.when(_, _)(return_(-1));
+
+    WHEN("it is called through a trampoline with a trailing context")
+    {
+      auto callback = trampoline_context_last(on_compare);
+
+      THEN("the action's value is returned")
+      {
+        CHECK(compare(callback.function, callback.context, 1, 2) == -1);
+        CHECK(on_compare.invoked(1, 2));
+      }
+    }
+  }
+}
+
+SCENARIO("mocked function invocations can be checked between checkpoints")
+{
+  GIVEN("a mocked function called in phases")
+  {
+    mock_function<void(int)> f;
+
+    f(1);
+    auto start = f.checkpoint();
+    f(2);
+    f(2);
+    auto end = checkpoint();
+    f(3);
+
+    THEN("each phase can be checked on its own")
+    {
+      CHECK(f.times(_) == 4);
+      CHECK(f.invoked_since(start, 3));
+      CHECK_FALSE(f.invoked_since(start, 1));
+      CHECK(f.times_since(start, _) == 3);
+      CHECK(f.invoked_between(start, end, 2));
+      CHECK_FALSE(f.invoked_between(start, end, 3));
+      CHECK(f.times_between(start, end, 2) == 2);
+    }
+  }
+}
@@ -73,7 +73,7 @@ struct test_base : base
 
   void take2(std::unique_ptr<int> p) override
   {
-    // return invoke<&test_base::take2>(*this, std::move(p));
+    return invoke<&test_base::take2>(*this, std::move(p));
   }
 };
 
@@ -253,6 +253,17 @@ SCENARIO("member functions can be mocked")
       }
     }
 
+    WHEN("calling a function that takes a move-only argument by value")
+    {
+      THEN("the log takes ownership of it")
+      {
+        auto p = std::make_unique<int>(42);
+        auto const address = p.get();
+        tb1->take2(std::move(p));
+        CHECK(tb1.invocations<&test_base::take2>().first().get<0>().get() == address);
+      }
+    }
+
     WHEN("an action throws an exception")
     {
       tb1.when<&test_base::test>(42)(throw_(std::runtime_error("poop")));
@@ -265,3 +276,38 @@ SCENARIO("member functions can be mocked")
     }
   }
 }
+
+SCENARIO("invocations can be checked between checkpoints")
+{
+  GIVEN("a mocked class used in phases")
+  {
+    mock<test_base> tb1;
+
+    tb1->test(1);
+    tb1->test(2);
+    auto warm = tb1.checkpoint();
+    tb1->test(2);
+    tb1->test(3);
+    tb1->value();
+    auto steady = checkpoint();
+    tb1->test(4);
+
+    THEN("each phase can be checked on its own")
+    {
+      CHECK(tb1.times<&test_base::test>(_) == 5);
+      CHECK(tb1.times<&test_base::test>(2) == 2);
+
+      CHECK_FALSE(tb1.invoked_since<&test_base::test>(warm, 1));
+      CHECK(tb1.invoked_since<&test_base::test>(warm, 4));
+      CHECK(tb1.times_since<&test_base::test>(warm, _) == 3);
+      CHECK(tb1.times_since<&test_base::test>(steady, _) == 1);
+
+      CHECK(tb1.invoked_between<&test_base::test>(warm, steady, 3));
+      CHECK_FALSE(tb1.invoked_between<&test_base::test>(warm, steady, 4));
+      CHECK(tb1.invoked_between<&test_base::value>(warm, steady));
+      CHECK(tb1.times_between<&test_base::test>(warm, steady, _) == 2);
+      CHECK(tb1.times_between<&test_base::test>(warm, steady, greater_than(2)) == 1);
+      CHECK(tb1.times_between<&test_base::test>(steady, warm, _) == 0);
+    }
+  }
+}
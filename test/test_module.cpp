@@ -0,0 +1,42 @@
+#include <catch2/catch.hpp>
+
+import mockup;
+
+struct foo
+{
+  virtual int bar(int x) = 0;
+};
+
+using namespace mockup;
+
+struct test_foo : foo
+{
+  int bar(int x) override
+  {
+    return invoke<&foo::bar>(*this, x);
+  }
+};
+
+SCENARIO("mockup can be imported as a module")
+{
+  GIVEN("a mocked class")
+  {
+    mock<test_foo> mock_foo;
+
+    WHEN("a function is invoked")
+    {
+      mock_foo.when<&foo::bar>(7)(return_(42));
+      mock_foo.when<&foo::bar>(greater_than(100))(return_(1));
+
+      CHECK(mock_foo->bar(7) == 42);
+      CHECK(mock_foo->bar(101) == 1);
+
+      THEN("the function invocation can be checked")
+      {
+        CHECK(mock_foo.invoked<&foo::bar>(7));
+        CHECK(mock_foo.invoked<&foo::bar>(_));
+        CHECK_FALSE(mock_foo.invoked<&foo::bar>(8));
+      }
+    }
+  }
+}
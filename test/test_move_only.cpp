@@ -0,0 +1,207 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <utility>
+
+using namespace mockup;
+
+namespace
+{
+  // A move-only handle that counts how often it is moved.
+  class handle
+  {
+  private:
+    int m_id;
+    int* m_moves;
+
+  public:
+    handle(int id, int* moves)
+    : m_id(id)
+    , m_moves(moves)
+    {
+    }
+
+    handle(handle const&) = delete;
+    handle& operator=(handle const&) = delete;
+
+    handle(handle&& other)
+    : m_id(std::exchange(other.m_id, 0))
+    , m_moves(other.m_moves)
+    {
+      ++*m_moves;
+    }
+
+    handle& operator=(handle&&) = delete;
+
+    int id() const
+    {
+      return m_id;
+    }
+  };
+
+  struct pool
+  {
+    virtual void give(std::unique_ptr<int> buffer) = 0;
+    virtual void adopt(handle h, int priority) = 0;
+  };
+
+  struct test_pool : pool
+  {
+    void give(std::unique_ptr<int> buffer) override
+    {
+      invoke<&pool::give>(*this, std::move(buffer));
+    }
+
+    void adopt(handle h, int priority) override
+    {
+      invoke<&pool::adopt>(*this, std::move(h), priority);
+    }
+  };
+} // namespace
+
+SCENARIO("move-only arguments taken by value are moved into the log")
+{
+  GIVEN("a mocked class with functions taking move-only arguments")
+  {
+    mock<test_pool> p;
+
+    WHEN("calls are made")
+    {
+      int moves = 0;
+      p->give(std::make_unique<int>(1));
+      p->give(nullptr);
+      p->adopt(handle(7, &moves), 2);
+
+      THEN("the log owns the arguments")
+      {
+        auto gives = p.invocations<&pool::give>();
+        CHECK(*gives.first().get<0>() == 1);
+        CHECK(gives.last().get<0>() == nullptr);
+        CHECK(p.invoked<&pool::give>(nullptr));
+        CHECK(p.times<&pool::give>(predicate([](std::unique_ptr<int> const& buffer) {
+                return buffer && *buffer == 1;
+              })) == 1);
+        CHECK(p.invocations<&pool::adopt>().first().get<0>().id() == 7);
+      }
+
+      THEN("each argument was moved once on its way into the log")
+      {
+        // Once into the parameter of `adopt`, once into the parameter of the mocked
+        // call and once into the log.
+        CHECK(moves == 3);
+      }
+    }
+
+    WHEN("an action takes an argument by value")
+    {
+      std::unique_ptr<int> taken;
+      p.when<&pool::give>(_)([&](std::unique_ptr<int> buffer) {
+        taken = std::move(buffer);
+      });
+      p->give(std::make_unique<int>(5));
+
+      THEN("ownership moves from the log to the action")
+      {
+        REQUIRE(taken);
+        CHECK(*taken == 5);
+        CHECK(p.invocations<&pool::give>().first().get<0>() == nullptr);
+      }
+    }
+
+    WHEN("an action takes an argument by reference")
+    {
+      int seen = 0;
+      p.when<&pool::give>(_)([&](std::unique_ptr<int> const& buffer) {
+        seen = *buffer;
+      });
+      p->give(std::make_unique<int>(6));
+
+      THEN("the log keeps ownership")
+      {
+        CHECK(seen == 6);
+        CHECK(*p.invocations<&pool::give>().first().get<0>() == 6);
+      }
+    }
+
+    WHEN("recording is disabled")
+    {
+      p.record<&pool::give>(false);
+      std::unique_ptr<int> taken;
+      p.when<&pool::give>(_)([&](std::unique_ptr<int> buffer) {
+        taken = std::move(buffer);
+      });
+      p->give(std::make_unique<int>(8));
+
+      THEN("the action receives the argument directly")
+      {
+        REQUIRE(taken);
+        CHECK(*taken == 8);
+        CHECK(p.invocations<&pool::give>().empty());
+      }
+    }
+
+    WHEN("the log uses the column layout")
+    {
+      p.layout<&pool::give>(log_layout::columns);
+      p->give(std::make_unique<int>(3));
+      p.layout<&pool::give>(log_layout::rows);
+      p->give(std::make_unique<int>(4));
+
+      THEN("owned arguments survive changes of layout")
+      {
+        CHECK(*p.invocations<&pool::give>().first().get<0>() == 3);
+        CHECK(*p.invocations<&pool::give>().last().get<0>() == 4);
+      }
+    }
+  }
+
+  GIVEN("a mock function taking a move-only argument")
+  {
+    mock_function<int(std::unique_ptr<int>)> f;
+    f.when(_)([](std::unique_ptr<int> const& buffer) {
+      return *buffer * 2;
+    });
+
+    WHEN("it is called")
+    {
+      auto const result = f(std::make_unique<int>(21));
+
+      THEN("the action sees the argument and the log owns it")
+      {
+        CHECK(result == 42);
+        CHECK(*f.invocations().first().get<0>() == 21);
+      }
+    }
+  }
+
+  GIVEN("a mock function whose action calls it again")
+  {
+    mock_function<int(std::unique_ptr<int>)> f;
+    f.when(_)([&f](std::unique_ptr<int> const& buffer) {
+      if (*buffer != 0)
+      {
+        // Enough calls for the log to move its storage.
+        for (int i = 0; i < 64; ++i)
+        {
+          f(std::make_unique<int>(0));
+        }
+      }
+      return *buffer;
+    });
+
+    WHEN("it is called")
+    {
+      auto const result = f(std::make_unique<int>(5));
+
+      THEN("the action still sees its argument and the log owns it")
+      {
+        CHECK(result == 5);
+        CHECK(*f.invocations().first().get<0>() == 5);
+        CHECK(*f.invocations().last().get<0>() == 0);
+        CHECK(f.times(_) == 65);
+      }
+    }
+  }
+}
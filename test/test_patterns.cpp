@@ -0,0 +1,162 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct socket
+  {
+    virtual void connect(std::string const& host) = 0;
+    virtual int send(int bytes) = 0;
+    virtual void close() = 0;
+  };
+
+  struct test_socket : socket
+  {
+    void connect(std::string const& host) override
+    {
+      invoke<&socket::connect>(*this, host);
+    }
+
+    int send(int bytes) override
+    {
+      return invoke<&socket::send>(*this, bytes);
+    }
+
+    void close() override
+    {
+      invoke<&socket::close>(*this);
+    }
+  };
+} // namespace
+
+SCENARIO("call patterns can be checked over several mocked functions")
+{
+  GIVEN("a mocked class")
+  {
+    mock<test_socket> sock;
+
+    auto session = then(
+        call<&socket::connect>(sock, _),
+        one_or_more(call<&socket::send>(sock, greater_than(0))),
+        call<&socket::close>(sock));
+
+    WHEN("the calls follow the pattern")
+    {
+      sock->connect("localhost");
+      sock->send(1);
+      sock->send(2);
+      sock->send(3);
+      sock->close();
+
+      THEN("the pattern matches")
+      {
+        CHECK(matches(session));
+        CHECK(matches(then(
+            call<&socket::connect>(sock, "localhost"),
+            zero_or_more(call<&socket::send>(sock, _)),
+            maybe(call<&socket::close>(sock)))));
+        CHECK_FALSE(matches(then(
+            call<&socket::connect>(sock, "remotehost"),
+            zero_or_more(call<&socket::send>(sock, _)),
+            call<&socket::close>(sock))));
+      }
+    }
+
+    WHEN("a required repetition is missing")
+    {
+      sock->connect("localhost");
+      sock->close();
+
+      THEN("the pattern does not match")
+      {
+        CHECK_FALSE(matches(session));
+      }
+    }
+
+    WHEN("a call breaks the pattern")
+    {
+      sock->connect("localhost");
+      sock->send(1);
+      sock->send(0);
+      sock->close();
+
+      THEN("the pattern does not match")
+      {
+        CHECK_FALSE(matches(session));
+        CHECK(matches(then(
+            call<&socket::connect>(sock, _),
+            one_or_more(either(
+                call<&socket::send>(sock, greater_than(0)), call<&socket::send>(sock, 0))),
+            call<&socket::close>(sock))));
+      }
+    }
+
+    WHEN("the pattern only mentions some of the functions")
+    {
+      sock->connect("localhost");
+      sock->send(1);
+      sock->close();
+
+      THEN("calls to the other functions are ignored")
+      {
+        CHECK(matches(then(call<&socket::connect>(sock, _), call<&socket::close>(sock))));
+      }
+    }
+  }
+
+  GIVEN("two mocked objects")
+  {
+    mock<test_socket> a;
+    mock<test_socket> b;
+
+    auto sessions = interleaved(
+        then(call<&socket::connect>(a, _), call<&socket::close>(a)),
+        then(call<&socket::connect>(b, _), call<&socket::close>(b)));
+
+    WHEN("their calls interleave")
+    {
+      a->connect("a");
+      b->connect("b");
+      a->close();
+      b->close();
+
+      THEN("the interleaved pattern matches")
+      {
+        CHECK(matches(sessions));
+      }
+    }
+
+    WHEN("one session is incomplete")
+    {
+      a->connect("a");
+      b->connect("b");
+      b->close();
+
+      THEN("the interleaved pattern does not match")
+      {
+        CHECK_FALSE(matches(sessions));
+      }
+    }
+  }
+
+  GIVEN("a mocked function called many times")
+  {
+    mock_function<void(int)> f;
+
+    for (int i = 0; i < 100000; ++i)
+    {
+      f(i % 2);
+    }
+
+    THEN("the pattern is checked in one pass")
+    {
+      CHECK(matches(one_or_more(then(call(f, 0), call(f, 1)))));
+      CHECK_FALSE(matches(one_or_more(call(f, 0))));
+    }
+  }
+}
@@ -0,0 +1,183 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct database
+  {
+    virtual int query(std::string const& sql) = 0;
+    virtual void insert(std::string const& key, int value) = 0;
+  };
+
+  struct real_database : database
+  {
+    int queries = 0;
+    int rows = 0;
+
+    int query(std::string const& sql) override
+    {
+      ++queries;
+      return static_cast<int>(sql.size()) + rows;
+    }
+
+    void insert(std::string const&, int) override
+    {
+      ++rows;
+    }
+  };
+
+  struct test_database : database
+  {
+    int query(std::string const& sql) override
+    {
+      return invoke<&database::query>(*this, sql);
+    }
+
+    void insert(std::string const& key, int value) override
+    {
+      invoke<&database::insert>(*this, key, value);
+    }
+  };
+
+  struct point
+  {
+    int x;
+    int y;
+
+    friend bool operator==(point const& lhs, point const& rhs)
+    {
+      return lhs.x == rhs.x && lhs.y == rhs.y;
+    }
+  };
+} // namespace
+
+SCENARIO("calls to a real implementation can be recorded and replayed")
+{
+  GIVEN("a mocked class spying on a real implementation")
+  {
+    real_database real;
+    recording<int(std::string const&)> queries;
+    recording<void(std::string const&, int)> inserts;
+    mock<test_database> db;
+    db.when<&database::query>(_)(spy(queries, [&](std::string const& sql) {
+      return real.query(sql);
+    }));
+    db.when<&database::insert>(_, _)(spy(inserts, [&](std::string const& key, int value) {
+      real.insert(key, value);
+    }));
+
+    db->query("select");
+    db->insert("a", 1);
+    db->query("select");
+    db->query("count");
+
+    THEN("calls are forwarded and recorded")
+    {
+      CHECK(real.queries == 3);
+      CHECK(real.rows == 1);
+      CHECK(queries.size() == 3);
+      CHECK(inserts.size() == 1);
+      CHECK(db.invoked<&database::query>(std::string("count")));
+    }
+
+    WHEN("the recording is replayed")
+    {
+      mock<test_database> replayed;
+      replayed.when<&database::query>(_)(replay(queries));
+      replayed.when<&database::insert>(_, _)(replay(inserts));
+
+      THEN("recorded results are served in order for each argument tuple")
+      {
+        CHECK(replayed->query("count") == 6);
+        CHECK(replayed->query("select") == 6);
+        CHECK(replayed->query("select") == 7);
+        CHECK(replayed->query("select") == 7);
+        replayed->insert("a", 1);
+        CHECK(real.queries == 3);
+      }
+
+      THEN("calls that were not recorded throw")
+      {
+        CHECK_THROWS_AS(replayed->query("delete"), std::out_of_range);
+        CHECK_THROWS_AS(replayed->insert("a", 2), std::out_of_range);
+      }
+    }
+
+    WHEN("the recording is saved and loaded")
+    {
+      std::stringstream stream;
+      queries.save(stream);
+      recording<int(std::string const&)> loaded(stream);
+      mock<test_database> replayed;
+      replayed.when<&database::query>(_)(replay(loaded));
+
+      THEN("the loaded recording is replayed")
+      {
+        CHECK(loaded.size() == 3);
+        CHECK(replayed->query("select") == 6);
+        CHECK(replayed->query("select") == 7);
+        CHECK(replayed->query("count") == 6);
+      }
+    }
+  }
+
+  GIVEN("a mock function spying on a function of arguments that cannot be hashed")
+  {
+    recording<int(point)> distances;
+    mock_function<int(point)> f;
+    f.when(_)(spy(distances, [](point p) {
+      return p.x + p.y;
+    }));
+    f(point{1, 2});
+    f(point{3, 4});
+
+    THEN("the recording is replayed")
+    {
+      mock_function<int(point)> g;
+      g.when(_)(replay(distances));
+      CHECK(g(point{3, 4}) == 7);
+      CHECK(g(point{1, 2}) == 3);
+      CHECK_THROWS_AS(g(point{2, 1}), std::out_of_range);
+    }
+  }
+
+  GIVEN("a stream that does not hold a recording")
+  {
+    std::stringstream stream("not a recording");
+
+    THEN("loading throws")
+    {
+      CHECK_THROWS_AS(recording<int(int)>(stream), std::runtime_error);
+    }
+  }
+
+  GIVEN("a recording whose arguments have no calls")
+  {
+    recording<int(int)> squares;
+    mock_function<int(int)> f;
+    f.when(_)(spy(squares, [](int x) {
+      return x * x;
+    }));
+    f(3);
+    std::stringstream saved;
+    squares.save(saved);
+
+    // The header is 20 bytes and the argument 4, followed by the number of calls and
+    // their results.
+    auto bytes = saved.str().substr(0, 24);
+    bytes.append(8, '\0');
+    std::stringstream stream(bytes);
+
+    THEN("loading throws")
+    {
+      CHECK_THROWS_AS(recording<int(int)>(stream), std::runtime_error);
+    }
+  }
+}
@@ -0,0 +1,166 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct meter
+  {
+    virtual void reading(std::int32_t id, std::int64_t total, float level, double ratio) = 0;
+    virtual void tagged(std::int32_t id, std::string const& tag) = 0;
+  };
+
+  struct test_meter : meter
+  {
+    void reading(std::int32_t id, std::int64_t total, float level, double ratio) override
+    {
+      invoke<&meter::reading>(*this, id, total, level, ratio);
+    }
+
+    void tagged(std::int32_t id, std::string const& tag) override
+    {
+      invoke<&meter::tagged>(*this, id, tag);
+    }
+  };
+
+  // Makes the same calls on a mock using each layout, so that every check can be
+  // compared between the block-at-a-time scan and the scan of one row at a time.
+  struct meters
+  {
+    mock<test_meter> rows;
+    mock<test_meter> columns;
+
+    meters()
+    {
+      columns.layout<&meter::reading>(log_layout::columns);
+      columns.layout<&meter::tagged>(log_layout::columns);
+    }
+
+    void reading(std::int32_t id, std::int64_t total, float level, double ratio)
+    {
+      rows->reading(id, total, level, ratio);
+      columns->reading(id, total, level, ratio);
+    }
+
+    void tagged(std::int32_t id, std::string const& tag)
+    {
+      rows->tagged(id, tag);
+      columns->tagged(id, tag);
+    }
+  };
+
+  template <typename... Matchers>
+  void check_times(meters& m, std::size_t expected, Matchers const&... matchers)
+  {
+    CHECK(m.rows.times<&meter::reading>(matchers...) == expected);
+    CHECK(m.columns.times<&meter::reading>(matchers...) == expected);
+    CHECK(m.columns.invoked<&meter::reading>(matchers...) == (expected != 0));
+  }
+} // namespace
+
+SCENARIO("comparison matchers are evaluated over log columns")
+{
+  GIVEN("mocks with a number of calls that is not a multiple of the block size")
+  {
+    meters m;
+    for (int i = 0; i < 1000; ++i)
+    {
+      m.reading(i % 10 - 5, std::int64_t(i) << 33, float(i % 7), i * 0.25);
+    }
+
+    THEN("every comparison counts the same calls with either layout")
+    {
+      check_times(m, 100, -5, _, _, _);
+      check_times(m, 100, equal_to(-5), _, _, _);
+      check_times(m, 900, not_equal_to(-5), _, _, _);
+      check_times(m, 300, less_than(-2), _, _, _);
+      check_times(m, 400, less_than_or_equal_to(-2), _, _, _);
+      check_times(m, 400, greater_than(0), _, _, _);
+      check_times(m, 500, greater_than_or_equal_to(0), _, _, _);
+
+      check_times(m, 1, _, std::int64_t(500) << 33, _, _);
+      check_times(m, 500, _, less_than(std::int64_t(500) << 33), _, _);
+      check_times(m, 499, _, greater_than(std::int64_t(500) << 33), _, _);
+      check_times(m, 500, _, greater_than_or_equal_to(std::int64_t(500) << 33), _, _);
+      check_times(m, 999, _, not_equal_to(std::int64_t(500) << 33), _, _);
+
+      check_times(m, 143, _, _, 3.0f, _);
+      check_times(m, 429, _, _, less_than(3.0f), _);
+      check_times(m, 428, _, _, greater_than(3.0f), _);
+      check_times(m, 857, _, _, not_equal_to(3.0f), _);
+
+      check_times(m, 1, _, _, _, 100.0);
+      check_times(m, 401, _, _, _, less_than_or_equal_to(100.0));
+      check_times(m, 599, _, _, _, greater_than(100.0));
+    }
+
+    THEN("comparisons combine across columns")
+    {
+      check_times(m, 43, 0, _, less_than(3.0f), _);
+      check_times(m, 17, 0, _, less_than(3.0f), less_than(100.0));
+      check_times(m, 0, 0, _, _, 100.0);
+      check_times(m, 1, 0, _, _, 101.25);
+    }
+
+    THEN("comparisons with operands of other types behave as the built-in operators")
+    {
+      check_times(m, 400, less_than(-1.5), _, _, _);
+      check_times(m, 100, 0L, _, _, _);
+      check_times(m, 1, _, _, _, 100);
+      check_times(m, 143, _, _, equal_to(3), _);
+    }
+
+    THEN("slices between checkpoints are scanned from any offset")
+    {
+      sequence seq;
+      CHECK(m.columns.invoked<&meter::reading>(seq, 4, _, _, _));
+      CHECK(m.columns.invoked<&meter::reading>(seq, 4, _, _, _));
+      CHECK(m.columns.times_since<&meter::reading>(checkpoint_t{seq.order}, 4, _, _, _) == 98);
+      CHECK(
+          m.rows.times_since<&meter::reading>(
+              checkpoint_t{m.rows.invocations<&meter::reading>().nth(19).order()}, 4, _, _, _) ==
+          98);
+    }
+  }
+
+  GIVEN("mocks recording NaN")
+  {
+    meters m;
+    auto const nan = std::numeric_limits<double>::quiet_NaN();
+    for (int i = 0; i < 10; ++i)
+    {
+      m.reading(i, 0, 0.0f, i % 2 == 0 ? nan : 1.0);
+    }
+
+    THEN("only inequality holds for NaN")
+    {
+      check_times(m, 5, _, _, _, 1.0);
+      check_times(m, 5, _, _, _, not_equal_to(1.0));
+      check_times(m, 0, _, _, _, less_than(1.0));
+      check_times(m, 5, _, _, _, greater_than_or_equal_to(1.0));
+    }
+  }
+
+  GIVEN("mocks recording arguments that cannot be compared in columns")
+  {
+    meters m;
+    for (int i = 0; i < 200; ++i)
+    {
+      m.tagged(i % 4, i % 3 == 0 ? "three" : "other");
+    }
+
+    THEN("the remaining matchers are checked for each candidate call")
+    {
+      CHECK(m.columns.times<&meter::tagged>(1, std::string("three")) == 16);
+      CHECK(m.rows.times<&meter::tagged>(1, std::string("three")) == 16);
+      CHECK(m.columns.times<&meter::tagged>(greater_than(1), std::string("three")) == 34);
+      CHECK(!m.columns.invoked<&meter::tagged>(4, std::string("three")));
+    }
+  }
+}
@@ -0,0 +1,198 @@
+#include <mockup/mockup.hpp>
+#include <mockup/spill.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__)
+#include <sys/resource.h>
+#endif
+
+using namespace mockup;
+
+namespace
+{
+  struct sensor
+  {
+    virtual void sample(int channel, double value) = 0;
+    virtual void reset(int channel) = 0;
+  };
+
+  struct test_sensor : sensor
+  {
+    void sample(int channel, double value) override
+    {
+      invoke<&sensor::sample>(*this, channel, value);
+    }
+
+    void reset(int channel) override
+    {
+      invoke<&sensor::reset>(*this, channel);
+    }
+  };
+
+  std::string spill_path(char const* name)
+  {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+} // namespace
+
+SCENARIO("invocation logs can spill to a memory-mapped file")
+{
+  GIVEN("a mocked class spilling the calls to a member function")
+  {
+    auto const path = spill_path("mockup_test_spill.bin");
+
+    {
+      mock<test_sensor> s;
+      s.spill<&sensor::sample>(path, 1000);
+
+      WHEN("more calls are made than are held in memory")
+      {
+        for (int i = 0; i < 10500; ++i)
+        {
+          s->sample(i % 4, i);
+          if (i == 5000)
+          {
+            s->reset(1);
+          }
+        }
+
+        THEN("queries cover spilled and resident calls")
+        {
+          CHECK(s.times<&sensor::sample>(_, _) == 10500);
+          CHECK(s.times<&sensor::sample>(1, _) == 2625);
+          CHECK(s.invoked<&sensor::sample>(0, 0.0));
+          CHECK(s.invoked<&sensor::sample>(3, 10499.0));
+          CHECK(!s.invoked<&sensor::sample>(0, 1.0));
+          CHECK(s.times<&sensor::sample>(_, greater_than_or_equal_to(10000.0)) == 500);
+          CHECK(s.invocations<&sensor::sample>().sum<1>() == 10499.0 * 10500 / 2);
+        }
+
+        THEN("calls keep their order")
+        {
+          auto samples = s.invocations<&sensor::sample>();
+          CHECK(samples.nth(999).get<1>() == 999.0);
+          CHECK(samples.nth(1000).order() == samples.nth(999).order() + 1);
+          CHECK(samples.nth(5001).order() == samples.nth(5000).order() + 2);
+
+          sequence seq;
+          CHECK(s.invoked<&sensor::sample>(seq, 0, 5000.0));
+          CHECK(s.invoked<&sensor::reset>(seq, 1));
+          CHECK(s.invoked<&sensor::sample>(seq, 1, 5001.0));
+          CHECK(!s.invoked<&sensor::sample>(seq, 0, 4000.0));
+        }
+      }
+
+      WHEN("the log uses the column layout")
+      {
+        s.layout<&sensor::sample>(log_layout::columns);
+        for (int i = 0; i < 2500; ++i)
+        {
+          s->sample(i % 2, i);
+        }
+
+        THEN("queries cover spilled and resident calls")
+        {
+          CHECK(s.times<&sensor::sample>(0, _) == 1250);
+          CHECK(s.times<&sensor::sample>(_, less_than(1500.0)) == 1500);
+          CHECK(s.invocations<&sensor::sample>().nth(2499).get<1>() == 2499.0);
+        }
+      }
+    }
+
+    CHECK(!std::filesystem::exists(path));
+  }
+
+  GIVEN("a mock function spilling compressed calls")
+  {
+    auto const path = spill_path("mockup_test_spill_runs.bin");
+
+    {
+      mock_function<void(int, int)> poll;
+      poll.compress(true);
+      poll.spill(path, 1);
+      for (int i = 0; i < 1000; ++i)
+      {
+        poll(4, 100);
+      }
+      poll(4, 0);
+      poll(4, 100);
+
+      THEN("runs continue across the spilled calls")
+      {
+        CHECK(poll.times(4, 100) == 1001);
+        CHECK(poll.times(_, 0) == 1);
+        CHECK(poll.invocations().nth(1000).get<1>() == 0);
+        CHECK(poll.invocations().nth(999).order() == poll.invocations().first().order() + 999);
+      }
+    }
+
+    CHECK(!std::filesystem::exists(path));
+  }
+
+  GIVEN("a mock function spilling to a file that is kept")
+  {
+    auto const path = spill_path("mockup_test_spill_kept.bin");
+
+    {
+      mock_function<void(int)> f;
+      f.spill(path, 1, true);
+      f(1);
+      f(2);
+      f(3);
+      CHECK(f.times(_) == 3);
+    }
+
+    THEN("the file holds the spilled calls after the mock is destroyed")
+    {
+      CHECK(std::filesystem::exists(path));
+      CHECK(std::filesystem::file_size(path) == 3 * 3 * sizeof(std::size_t));
+    }
+
+    std::filesystem::remove(path);
+  }
+
+#if defined(__unix__)
+  GIVEN("a mapped file that can grow but not be mapped again")
+  {
+    detail::mapped_file file(spill_path("mockup_test_spill_unmapped.bin"));
+    std::memset(file.append(16), 7, 16);
+
+    // A limit on the address space lets the file grow, since it is sparse, but not be
+    // mapped at its new size.
+    rlimit old_limit;
+    getrlimit(RLIMIT_AS, &old_limit);
+    auto limit = old_limit;
+    limit.rlim_cur = std::min<rlim_t>(old_limit.rlim_cur, rlim_t(1) << 36);
+    setrlimit(RLIMIT_AS, &limit);
+    auto const failed = [&] {
+      try
+      {
+        file.append(std::size_t(1) << 40);
+        return false;
+      }
+      catch (std::system_error const&)
+      {
+        return true;
+      }
+    }();
+    setrlimit(RLIMIT_AS, &old_limit);
+
+    THEN("appending throws and the data appended before is still mapped")
+    {
+      CHECK(failed);
+      REQUIRE(file.size() == 16);
+      CHECK(file.data()[15] == std::byte{7});
+      std::memset(file.append(16), 8, 16);
+      CHECK(file.data()[31] == std::byte{8});
+    }
+  }
+#endif
+}
@@ -0,0 +1,144 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mockup;
+
+namespace
+{
+  struct point
+  {
+    int x;
+    int y;
+
+    friend bool operator==(point const& lhs, point const& rhs)
+    {
+      return lhs.x == rhs.x && lhs.y == rhs.y;
+    }
+  };
+
+  struct canvas
+  {
+    virtual void move_to(point const& p) = 0;
+    virtual void label(std::string const& text, double size) = 0;
+  };
+
+  struct test_canvas : canvas
+  {
+    void move_to(point const& p) override
+    {
+      invoke<&canvas::move_to>(*this, p);
+    }
+
+    void label(std::string const& text, double size) override
+    {
+      invoke<&canvas::label>(*this, text, size);
+    }
+  };
+} // namespace
+
+template <>
+struct mockup::serializer<point>
+{
+  static void write(std::ostream& out, point const& p)
+  {
+    serializer<int>::write(out, p.x);
+    serializer<int>::write(out, p.y);
+  }
+
+  static point read(std::istream& in)
+  {
+    auto const x = serializer<int>::read(in);
+    return {x, serializer<int>::read(in)};
+  }
+};
+
+SCENARIO("recorded calls can be exported to a trace and loaded again")
+{
+  GIVEN("a trace of the calls to a mocked class")
+  {
+    std::stringstream stream;
+    {
+      mock<test_canvas> c;
+      c->move_to({1, 2});
+      c->label("origin", 12.0);
+      c->move_to({3, 4});
+      c->label("end", 9.5);
+
+      trace_writer writer(stream);
+      writer.write("move_to", c.invocations<&canvas::move_to>());
+      writer.write("label", c.invocations<&canvas::label>());
+    }
+
+    WHEN("the trace is loaded")
+    {
+      trace t(stream);
+      auto moves = t.function<void(point const&)>("move_to");
+      auto labels = t.function<void(std::string const&, double)>("label");
+
+      THEN("the calls can be queried")
+      {
+        CHECK(t.functions() == std::vector<std::string>{"label", "move_to"});
+        CHECK(moves.invoked(point{3, 4}));
+        CHECK(!moves.invoked(point{4, 3}));
+        CHECK(labels.times(_, greater_than(10.0)) == 1);
+        CHECK(labels.invocations().last().get<0>() == "end");
+      }
+
+      THEN("the calls keep their orders")
+      {
+        sequence seq;
+        CHECK(moves.invoked(seq, point{1, 2}));
+        CHECK(labels.invoked(seq, std::string("origin"), 12.0));
+        CHECK(moves.invoked(seq, point{3, 4}));
+        CHECK(!labels.invoked(seq, std::string("origin"), _));
+        CHECK(labels.invoked(seq, std::string("end"), _));
+      }
+    }
+
+    WHEN("a function is loaded with the wrong signature")
+    {
+      trace t(stream);
+
+      THEN("loading throws")
+      {
+        CHECK_THROWS_AS(t.function<void(int)>("move_to"), std::runtime_error);
+        CHECK_THROWS_AS(t.function<void(point const&)>("resize"), std::out_of_range);
+      }
+    }
+  }
+
+  GIVEN("a mock function whose calls are filtered before they are traced")
+  {
+    mock_function<void(int, bool)> f;
+    for (int i = 0; i < 10; ++i)
+    {
+      f(i, i % 3 == 0);
+    }
+    std::stringstream stream;
+    trace_writer(stream).write("f", f.invocations().where(_, true));
+
+    THEN("only the filtered calls are in the trace")
+    {
+      auto calls = trace(stream).function<void(int, bool)>("f");
+      CHECK(calls.times(_, _) == 4);
+      CHECK(calls.invoked(9, true));
+      CHECK(!calls.invoked(1, _));
+    }
+  }
+
+  GIVEN("a stream that does not hold a trace")
+  {
+    std::stringstream stream("not a trace");
+
+    THEN("loading throws")
+    {
+      CHECK_THROWS_AS(trace(stream), std::runtime_error);
+    }
+  }
+}
@@ -0,0 +1,166 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct file
+  {
+    virtual void write(std::string const& name, std::size_t bytes) = 0;
+    virtual void flush(int batch) = 0;
+  };
+
+  struct test_file : file
+  {
+    void write(std::string const& name, std::size_t bytes) override
+    {
+      invoke<&file::write>(*this, name, bytes);
+    }
+
+    void flush(int batch) override
+    {
+      invoke<&file::flush>(*this, batch);
+    }
+  };
+} // namespace
+
+SCENARIO("recorded arguments can be aggregated")
+{
+  GIVEN("a mocked class with recorded invocations")
+  {
+    mock<test_file> f;
+    for (std::size_t i = 1; i <= 100; ++i)
+    {
+      f->write(i % 2 == 0 ? "even" : "odd", i);
+      f->flush(static_cast<int>(i % 7));
+    }
+
+    THEN("views compute aggregates of one argument")
+    {
+      auto writes = f.invocations<&file::write>();
+      CHECK(writes.sum<1>() == 5050);
+      CHECK(writes.min<1>() == 1);
+      CHECK(writes.max<1>() == 100);
+      CHECK(writes.max<0>() == "odd");
+      CHECK(writes.distinct_count<0>() == 2);
+      CHECK(writes.histogram<0>().at("even") == 50);
+
+      auto flushes = f.invocations<&file::flush>();
+      CHECK(flushes.max<0>() == 6);
+      CHECK(flushes.distinct_count<0>() == 7);
+      CHECK(flushes.histogram<0>().at(0) == 14);
+    }
+
+    THEN("filtered views aggregate only the matching invocations")
+    {
+      auto even = f.invocations<&file::write>().where(std::string("even"), _);
+      CHECK(even.sum<1>() == 2550);
+      CHECK(even.min<1>() == 2);
+      CHECK(even.distinct_count<1>() == 50);
+      CHECK(even.histogram<0>().size() == 1);
+    }
+
+    THEN("views in the column layout give the same aggregates")
+    {
+      f.layout<&file::write>(log_layout::columns);
+      auto writes = f.invocations<&file::write>();
+      CHECK(writes.sum<1>() == 5050);
+      CHECK(writes.max<1>() == 100);
+      CHECK(writes.distinct_count<0>() == 2);
+      CHECK(writes.where(std::string("odd"), _).sum<1>() == 2500);
+    }
+
+    THEN("empty views have no minimum or maximum")
+    {
+      auto none = f.invocations<&file::write>().where(std::string("none"), _);
+      CHECK(none.sum<1>() == 0);
+      CHECK(none.distinct_count<1>() == 0);
+      CHECK(none.histogram<1>().empty());
+      CHECK_THROWS_AS(none.min<1>(), std::out_of_range);
+      CHECK_THROWS_AS(none.max<1>(), std::out_of_range);
+    }
+  }
+
+  GIVEN("a mocked class tracking arguments with recording disabled")
+  {
+    mock<test_file> f;
+    f.record<&file::write>(false);
+    f.record<&file::flush>(false);
+    auto bytes = f.track<&file::write, 1>();
+    auto names = f.track_histogram<&file::write, 0>();
+    auto batches = f.track<&file::flush, 0>();
+
+    THEN("nothing has been tracked")
+    {
+      CHECK(bytes.count() == 0);
+      CHECK(bytes.sum() == 0);
+      CHECK_THROWS_AS(bytes.min(), std::out_of_range);
+      CHECK_THROWS_AS(bytes.max(), std::out_of_range);
+      CHECK(names.distinct_count() == 0);
+    }
+
+    WHEN("calls are made")
+    {
+      for (std::size_t i = 1; i <= 100; ++i)
+      {
+        f->write(i % 2 == 0 ? "even" : "odd", i);
+        f->flush(static_cast<int>(i % 7) - 3);
+      }
+
+      THEN("the aggregates are updated as the calls are made")
+      {
+        CHECK(f.invocations<&file::write>().empty());
+        CHECK(bytes.count() == 100);
+        CHECK(bytes.sum() == 5050);
+        CHECK(bytes.min() == 1);
+        CHECK(bytes.max() == 100);
+        CHECK(batches.min() == -3);
+        CHECK(batches.max() == 3);
+        CHECK(names.count() == 100);
+        CHECK(names.distinct_count() == 2);
+        CHECK(names.histogram().at("odd") == 50);
+      }
+    }
+  }
+
+  GIVEN("a mock function tracking an argument")
+  {
+    mock_function<void(int, double)> f;
+    auto weights = f.track<1>();
+
+    WHEN("it is called")
+    {
+      f(1, 0.5);
+      f(2, 1.5);
+      f(3, -1.0);
+
+      THEN("both the tracked and the recorded aggregates are available")
+      {
+        CHECK(weights.sum() == 1.0);
+        CHECK(weights.min() == -1.0);
+        CHECK(f.invocations().sum<0>() == 6);
+        CHECK(f.invocations().max<1>() == 1.5);
+      }
+    }
+  }
+
+  GIVEN("a mock function tracking an argument whose total does not fit its type")
+  {
+    mock_function<void(int)> f;
+    auto sizes = f.track<0>();
+    f(2000000000);
+    f(2000000000);
+
+    THEN("the totals are summed in a wider type")
+    {
+      CHECK(sizes.sum() == 4000000000LL);
+      CHECK(f.invocations().sum<0>() == 4000000000LL);
+    }
+  }
+}
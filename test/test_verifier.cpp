@@ -0,0 +1,94 @@
+#include <mockup/mockup.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+using namespace mockup;
+
+namespace
+{
+  struct store
+  {
+    virtual void put(std::string const& key, int value) = 0;
+    virtual int get(std::string const& key) const = 0;
+  };
+
+  struct test_store : store
+  {
+    void put(std::string const& key, int value) override
+    {
+      invoke<&store::put>(*this, key, value);
+    }
+
+    int get(std::string const& key) const override
+    {
+      return invoke<&store::get>(*this, key);
+    }
+  };
+} // namespace
+
+SCENARIO("many checks can be verified in one pass over each log")
+{
+  GIVEN("a mocked class with recorded invocations")
+  {
+    mock<test_store> s;
+
+    for (int i = 0; i < 100; ++i)
+    {
+      s->put("key" + std::to_string(i % 10), i);
+      s->get("key" + std::to_string(i % 10));
+    }
+
+    WHEN("checks are collected in a verifier")
+    {
+      verifier v;
+      auto put_0 = v.invoked<&store::put>(s, std::string("key0"), 0);
+      auto put_1 = v.invoked<&store::put>(s, std::string("key1"), 1);
+      auto put_missing = v.invoked<&store::put>(s, std::string("key0"), 1);
+      auto get_0 = v.times<&store::get>(s, 10, std::string("key0"));
+      auto get_0_again = v.at_least<&store::get>(s, 5, std::string("key0"));
+      auto get_any = v.times<&store::get>(s, 100, _);
+      auto put_large = v.at_most<&store::put>(s, 9, _, greater_than_or_equal_to(90));
+      auto never_put = v.never<&store::put>(s, "other", _);
+
+      auto report = v.verify();
+
+      THEN("the report contains the result of each check")
+      {
+        CHECK(report.size() == 8);
+        CHECK(report[put_0].passed);
+        CHECK(report[put_1].passed);
+        CHECK_FALSE(report[put_missing].passed);
+        CHECK(report[get_0].passed);
+        CHECK(report[get_0].count == 10);
+        CHECK(report[get_0_again].passed);
+        CHECK(report[get_any].passed);
+        CHECK_FALSE(report[put_large].passed);
+        CHECK(report[put_large].count == 10);
+        CHECK(report[never_put].passed);
+
+        CHECK_FALSE(report.passed());
+        CHECK(report.failures() == std::vector<std::size_t>{put_missing, put_large});
+      }
+    }
+  }
+
+  GIVEN("a mocked function with recorded invocations")
+  {
+    mock_function<void(int)> f;
+    f(1);
+    f(2);
+    f(2);
+
+    THEN("it can be verified too")
+    {
+      verifier v;
+      v.invoked(f, 1);
+      v.times(f, 2, 2);
+      v.never(f, 3);
+      v.at_most(f, 3, _);
+      CHECK(v.verify().passed());
+    }
+  }
+}
@@ -0,0 +1,44 @@
+// Compares a trace with a golden trace, both written by `mockup::trace_writer`, one call
+// at a time, and reports the first call that differs. Exits with 0 if the traces hold the
+// same calls, 1 if they differ and 2 if they cannot be read.
+
+#include <mockup/golden.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+  if (argc != 3 && argc != 4)
+  {
+    std::cerr << "usage: " << argv[0] << " <golden trace> <trace> [context]\n";
+    return 2;
+  }
+  try
+  {
+    std::ifstream golden(argv[1], std::ios::binary);
+    std::ifstream actual(argv[2], std::ios::binary);
+    if (!golden || !actual)
+    {
+      std::cerr << "cannot open " << (golden ? argv[2] : argv[1]) << "\n";
+      return 2;
+    }
+    auto const context = argc == 4 ? std::stoul(argv[3]) : 8;
+    mockup::golden_trace trace(golden, context);
+    if (!trace.compare(actual))
+    {
+      std::cout << trace.report();
+      return 1;
+    }
+    std::cout << "traces match: " << trace.matched() << " calls\n";
+    return 0;
+  }
+  catch (std::exception const& e)
+  {
+    std::cerr << e.what() << "\n";
+    return 2;
+  }
+}